@@ -0,0 +1,293 @@
+/*******************************************************************************************
+*
+*   raymap - 06_threaded_mapping
+*
+*   DESCRIPTION:
+*       Point mapping from worker threads while the render thread keeps moving the quad.
+*       Tracker threads call RM_UnmapPoints()/RM_MapPoints() in a loop without any lock,
+*       the render thread calls RM_SetQuad() every frame. Doubles as a contention
+*       benchmark: the HUD shows mapped points per second per thread and in total.
+*
+*   DEPENDENCIES:
+*       raylib 5.0+
+*       raymap 1.1.0+
+*       pthreads
+*
+*   COMPILATION (Linux):
+*       gcc 06_threaded_mapping.c -o 06_threaded_mapping -lraylib -lm -lpthread
+*
+*   COMPILATION (macOS):
+*       clang 06_threaded_mapping.c -o 06_threaded_mapping -lraylib -framework CoreVideo \
+*             -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL
+*
+*   COMPILATION (Windows - MinGW):
+*       gcc 06_threaded_mapping.c -o 06_threaded_mapping.exe -lraylib -lopengl32 -lgdi32 -lwinmm -lpthread
+*
+*   CONTROLS:
+*       1-8         - Number of tracker threads
+*       0           - Stop all tracker threads
+*       SPACE       - Toggle quad animation (one RM_SetQuad per frame)
+*       M           - Toggle BILINEAR / HOMOGRAPHY
+*       D           - Toggle dynamic vertex buffers (compare upload stalls)
+*       C           - Toggle calibration mode
+*       ESC         - Exit
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2026 grerfou
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYMAP_IMPLEMENTATION
+#include "raymap.h"
+
+#include <pthread.h>
+#include <math.h>
+
+#define MAX_TRACKERS 8
+#define BATCH_SIZE 1024
+
+// Tracker thread state (padded so counters of different threads never share a cache line)
+typedef struct {
+    pthread_t thread;
+    RM_Surface *surface;
+    volatile bool running;
+    volatile long long points;      // Points mapped since start
+    Vector2 lastUV;                 // Last unmapped blob position, for display
+    char pad[64];
+} Tracker;
+
+// Simulated tracking loop: unmap a cloud of screen points, map a few back
+static void *TrackerMain(void *arg)
+{
+    Tracker *tracker = (Tracker *)arg;
+    Vector2 screen[BATCH_SIZE];
+    Vector2 uv[BATCH_SIZE];
+    Vector2 corners[4] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+    Vector2 mapped[4];
+
+    unsigned int seed = (unsigned int)(size_t)arg;
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        seed = seed * 1103515245u + 12345u;
+        screen[i].x = 200.0f + (float)((seed >> 8) % 1500);
+        seed = seed * 1103515245u + 12345u;
+        screen[i].y = 100.0f + (float)((seed >> 8) % 880);
+    }
+
+    while (tracker->running) {
+        RM_UnmapPoints(tracker->surface, screen, uv, BATCH_SIZE);
+        RM_MapPoints(tracker->surface, corners, mapped, 4);
+        tracker->lastUV = uv[0];
+        tracker->points += BATCH_SIZE + 4;
+    }
+
+    return NULL;
+}
+
+static void StartTrackers(Tracker *trackers, int count, RM_Surface *surface)
+{
+    for (int i = 0; i < count; i++) {
+        trackers[i].surface = surface;
+        trackers[i].running = true;
+        trackers[i].points = 0;
+        pthread_create(&trackers[i].thread, NULL, TrackerMain, &trackers[i]);
+    }
+}
+
+static void StopTrackers(Tracker *trackers, int count)
+{
+    for (int i = 0; i < count; i++) trackers[i].running = false;
+    for (int i = 0; i < count; i++) pthread_join(trackers[i].thread, NULL);
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1920;
+    const int screenHeight = 1080;
+
+    InitWindow(screenWidth, screenHeight, "RayMap - 06 Threaded Mapping");
+    SetTargetFPS(60);
+
+    // Create surface
+    RM_Surface *surface = RM_CreateSurface(800, 600, RM_MAP_HOMOGRAPHY);
+
+    if (!surface) {
+        TraceLog(LOG_ERROR, "Failed to create surface!");
+        CloseWindow();
+        return -1;
+    }
+
+    RM_Quad baseQuad = {
+        .topLeft = { 250, 100 },
+        .topRight = { 1670, 120 },
+        .bottomRight = { 1600, 950 },
+        .bottomLeft = { 320, 980 }
+    };
+    RM_SetQuad(surface, baseQuad);
+
+    RM_Calibration calibration = RM_CalibrationDefault(surface);
+    calibration.enabled = false;
+
+    // Tracker threads
+    Tracker trackers[MAX_TRACKERS] = { 0 };
+    int trackerCount = 4;
+    StartTrackers(trackers, trackerCount, surface);
+
+    bool animate = true;
+    float animTime = 0.0f;
+
+    // Throughput measurement (refreshed twice per second)
+    long long lastPoints[MAX_TRACKERS] = { 0 };
+    double lastSample = GetTime();
+    double rate[MAX_TRACKERS] = { 0 };
+    double totalRate = 0.0;
+
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        //----------------------------------------------------------------------------------
+        // Update
+        //----------------------------------------------------------------------------------
+
+        // Change tracker count
+        for (int key = KEY_ZERO; key <= KEY_EIGHT; key++) {
+            if (IsKeyPressed(key) && (key - KEY_ZERO) != trackerCount) {
+                StopTrackers(trackers, trackerCount);
+                trackerCount = key - KEY_ZERO;
+                StartTrackers(trackers, trackerCount, surface);
+                for (int i = 0; i < MAX_TRACKERS; i++) {
+                    lastPoints[i] = 0;
+                    rate[i] = 0.0;
+                }
+                totalRate = 0.0;
+                lastSample = GetTime();
+            }
+        }
+
+        if (IsKeyPressed(KEY_SPACE)) animate = !animate;
+
+        if (IsKeyPressed(KEY_M)) {
+            RM_MapMode mode = RM_GetMapMode(surface);
+            RM_SetMapMode(surface, (mode == RM_MAP_BILINEAR) ? RM_MAP_HOMOGRAPHY : RM_MAP_BILINEAR);
+        }
+
+        if (IsKeyPressed(KEY_D)) {
+            RM_SetSurfaceDynamic(surface, !RM_IsSurfaceDynamic(surface));
+            RM_ResetBufferStats(surface);
+        }
+
+        if (IsKeyPressed(KEY_C)) {
+            RM_ToggleCalibration(&calibration);
+            animate = false;
+        }
+
+        RM_UpdateCalibration(&calibration);
+
+        // Writer side: one quad update per frame while trackers keep reading
+        if (animate) {
+            animTime += GetFrameTime();
+            float dx = 40.0f * sinf(animTime * 1.7f);
+            float dy = 30.0f * cosf(animTime * 1.3f);
+
+            RM_Quad quad = baseQuad;
+            quad.topLeft.x += dx;
+            quad.topRight.y += dy;
+            quad.bottomRight.x -= dx;
+            quad.bottomLeft.y -= dy;
+            RM_SetQuad(surface, quad);
+        }
+
+        // Sample throughput
+        double now = GetTime();
+        if (now - lastSample >= 0.5) {
+            double elapsed = now - lastSample;
+            totalRate = 0.0;
+            for (int i = 0; i < trackerCount; i++) {
+                long long points = trackers[i].points;
+                rate[i] = (double)(points - lastPoints[i]) / elapsed;
+                lastPoints[i] = points;
+                totalRate += rate[i];
+            }
+            lastSample = now;
+        }
+
+        //----------------------------------------------------------------------------------
+        // Draw to surface
+        //----------------------------------------------------------------------------------
+        RM_BeginSurface(surface);
+            ClearBackground((Color){ 25, 35, 45, 255 });
+
+            for (int x = 0; x <= 8; x++) DrawLine(x * 100, 0, x * 100, 600, ColorAlpha(DARKGRAY, 0.5f));
+            for (int y = 0; y <= 6; y++) DrawLine(0, y * 100, 800, y * 100, ColorAlpha(DARKGRAY, 0.5f));
+
+            DrawText("THREADED MAPPING", 200, 60, 40, WHITE);
+            DrawText("Trackers read the quad while it moves", 200, 110, 20, LIGHTGRAY);
+
+            // First sample of each tracker, unmapped on its own thread
+            for (int i = 0; i < trackerCount; i++) {
+                Vector2 uv = trackers[i].lastUV;
+                if (uv.x >= 0.0f) DrawCircle((int)(uv.x * 800), (int)(uv.y * 600), 10, ColorFromHSV(i * 45.0f, 0.8f, 0.9f));
+            }
+        RM_EndSurface(surface);
+
+        //----------------------------------------------------------------------------------
+        // Draw to screen
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+            ClearBackground(BLACK);
+
+            RM_DrawSurface(surface);
+
+            if (calibration.enabled) {
+                RM_DrawCalibration(calibration);
+            }
+
+            // HUD
+            DrawText("RAYMAP - THREADED MAPPING", 10, 10, 20, GREEN);
+            DrawFPS(screenWidth - 100, 10);
+
+            int panelHeight = 175 + trackerCount * 22;
+            DrawRectangle(10, 50, 420, panelHeight, Fade(BLACK, 0.7f));
+            DrawRectangleLines(10, 50, 420, panelHeight, GREEN);
+
+            DrawText(TextFormat("Mode: %s", (RM_GetMapMode(surface) == RM_MAP_HOMOGRAPHY) ? "HOMOGRAPHY" : "BILINEAR"),
+                     20, 60, 18, YELLOW);
+            DrawText(TextFormat("Trackers: %d   Quad updates: %s", trackerCount, animate ? "every frame" : "paused"),
+                     20, 85, 16, WHITE);
+            DrawText(TextFormat("Total: %.1f Mpts/s", totalRate / 1e6), 20, 110, 18, LIME);
+
+            for (int i = 0; i < trackerCount; i++) {
+                DrawText(TextFormat("  thread %d: %.1f Mpts/s", i, rate[i] / 1e6), 20, 140 + i * 22, 16, LIGHTGRAY);
+            }
+
+            RM_BufferStats stats = RM_GetBufferStats(surface);
+            DrawText(TextFormat("Buffers: %s   uploads %u  stalls %u  max %.2f ms",
+                     RM_IsSurfaceDynamic(surface) ? "dynamic" : "static",
+                     stats.uploads, stats.stalls, stats.maxUploadMs),
+                     20, 140 + trackerCount * 22 + 10, 14, SKYBLUE);
+
+            DrawText("[0-8] Trackers  [SPACE] Animate  [M] Mode  [D] Dynamic  [C] Calibrate",
+                     20, 140 + trackerCount * 22 + 35, 14, GRAY);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    StopTrackers(trackers, trackerCount);
+    RM_DestroySurface(surface);
+    CloseWindow();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
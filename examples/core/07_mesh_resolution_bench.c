@@ -0,0 +1,301 @@
+/*******************************************************************************************
+*
+*   raymap - 07_mesh_resolution_bench
+*
+*   DESCRIPTION:
+*       Mesh resolution benchmark from 16x16 to 512x512. For every resolution it measures:
+*         - rebuild: first RM_DrawSurface() after a resolution change (generation + upload)
+*         - drag:    RM_SetQuad() + RM_DrawSurface() at the same resolution (in-place update)
+*         - upload:  average position buffer update reported by RM_GetBufferStats()
+*         - frame:   average frame time with the quad static (no frame limit)
+*         - kernel:  CPU position generation against per-vertex evaluation (speedup and
+*                    largest difference in pixels, from RM_CompareMeshKernel)
+*       Grids above 65535 vertices are drawn in row bands, the HUD shows the draw call count.
+*       Results are printed with TraceLog when a run completes.
+*
+*   DEPENDENCIES:
+*       raylib 5.0+
+*       raymap 1.1.0+
+*
+*   COMPILATION (Linux):
+*       gcc 07_mesh_resolution_bench.c -o 07_mesh_resolution_bench -lraylib -lm
+*
+*   COMPILATION (macOS):
+*       clang 07_mesh_resolution_bench.c -o 07_mesh_resolution_bench -lraylib -framework CoreVideo \
+*             -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL
+*
+*   COMPILATION (Windows - MinGW):
+*       gcc 07_mesh_resolution_bench.c -o 07_mesh_resolution_bench.exe -lraylib -lopengl32 -lgdi32 -lwinmm
+*
+*   CONTROLS:
+*       SPACE       - Restart the benchmark
+*       M           - Toggle BILINEAR / HOMOGRAPHY (restarts)
+*       F           - Cycle vertex format DEFAULT / COMPACT / COMPACT16 (restarts)
+*       D           - Toggle dynamic vertex buffers (restarts)
+*       ESC         - Exit
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2026 grerfou
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYMAP_DEBUG                        // RM_CompareMeshKernel
+#define RAYMAP_IMPLEMENTATION
+#include "raymap.h"
+
+#include <math.h>
+
+#define RESOLUTION_COUNT 7
+#define REBUILD_SAMPLES 10
+#define DRAG_SAMPLES 60
+#define FRAME_SAMPLES 60
+
+// Measured times of one resolution (milliseconds)
+typedef struct {
+    int resolution;
+    double rebuildMs;
+    double dragMs;
+    double uploadMs;
+    double frameMs;
+    double kernelMs;
+    double referenceMs;
+    float kernelError;
+    bool done;
+} BenchResult;
+
+typedef enum {
+    PHASE_REBUILD = 0,
+    PHASE_DRAG,
+    PHASE_FRAME,
+    PHASE_DONE
+} BenchPhase;
+
+static const int resolutions[RESOLUTION_COUNT] = { 16, 32, 64, 128, 256, 384, 512 };
+static const char *formatNames[3] = { "DEFAULT", "COMPACT", "COMPACT16" };
+
+static void ResetResults(BenchResult *results)
+{
+    for (int i = 0; i < RESOLUTION_COUNT; i++) {
+        results[i] = (BenchResult){ 0 };
+        results[i].resolution = resolutions[i];
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1920;
+    const int screenHeight = 1080;
+
+    InitWindow(screenWidth, screenHeight, "RayMap - 07 Mesh Resolution Benchmark");
+    SetTargetFPS(0);                        // Unlimited: frame time is the measurement
+
+    // Create surface
+    RM_Surface *surface = RM_CreateSurface(800, 600, RM_MAP_HOMOGRAPHY);
+
+    if (!surface) {
+        TraceLog(LOG_ERROR, "Failed to create surface!");
+        CloseWindow();
+        return -1;
+    }
+
+    RM_Quad baseQuad = {
+        .topLeft = { 350, 120 },
+        .topRight = { 1570, 180 },
+        .bottomRight = { 1750, 960 },
+        .bottomLeft = { 170, 900 }
+    };
+    RM_SetQuad(surface, baseQuad);
+
+    // Draw the content once, the benchmark only measures the mesh
+    RM_BeginSurface(surface);
+        ClearBackground((Color){ 25, 35, 45, 255 });
+        for (int x = 0; x <= 16; x++) DrawLine(x * 50, 0, x * 50, 600, ColorAlpha(SKYBLUE, 0.6f));
+        for (int y = 0; y <= 12; y++) DrawLine(0, y * 50, 800, y * 50, ColorAlpha(SKYBLUE, 0.6f));
+        DrawCircleLines(400, 300, 250, YELLOW);
+        DrawText("MESH BENCHMARK", 220, 270, 50, WHITE);
+    RM_EndSurface(surface);
+
+    BenchResult results[RESOLUTION_COUNT];
+    ResetResults(results);
+
+    int current = 0;
+    BenchPhase phase = PHASE_REBUILD;
+    int sample = 0;
+    double accum = 0.0;
+    int format = RM_VERTEX_DEFAULT;
+
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        //----------------------------------------------------------------------------------
+        // Update
+        //----------------------------------------------------------------------------------
+        bool restart = IsKeyPressed(KEY_SPACE);
+
+        if (IsKeyPressed(KEY_M)) {
+            RM_MapMode mode = RM_GetMapMode(surface);
+            RM_SetMapMode(surface, (mode == RM_MAP_BILINEAR) ? RM_MAP_HOMOGRAPHY : RM_MAP_BILINEAR);
+            restart = true;
+        }
+
+        if (IsKeyPressed(KEY_F)) {
+            format = (format + 1) % 3;
+            RM_SetVertexFormat(surface, (RM_VertexFormat)format);
+            restart = true;
+        }
+
+        if (IsKeyPressed(KEY_D)) {
+            RM_SetSurfaceDynamic(surface, !RM_IsSurfaceDynamic(surface));
+            restart = true;
+        }
+
+        if (restart) {
+            ResetResults(results);
+            current = 0;
+            phase = PHASE_REBUILD;
+            sample = 0;
+            accum = 0.0;
+            RM_SetQuad(surface, baseQuad);
+        }
+
+        //----------------------------------------------------------------------------------
+        // Draw to screen
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+            ClearBackground(BLACK);
+
+            if (phase == PHASE_REBUILD) {
+                // Leave the grid, then time the first draw at the measured resolution
+                RM_SetMeshResolution(surface, 4, 4);
+                RM_DrawSurface(surface);
+                RM_SetMeshResolution(surface, resolutions[current], resolutions[current]);
+
+                double start = GetTime();
+                RM_DrawSurface(surface);
+                accum += GetTime() - start;
+
+                if (++sample == REBUILD_SAMPLES) {
+                    results[current].rebuildMs = accum * 1000.0 / REBUILD_SAMPLES;
+                    phase = PHASE_DRAG;
+                    sample = 0;
+                    accum = 0.0;
+                    RM_ResetBufferStats(surface);
+                }
+            } else if (phase == PHASE_DRAG) {
+                // Same resolution, new corners every frame
+                float t = (float)sample * 0.1f;
+                RM_Quad quad = baseQuad;
+                quad.topLeft.x += 40.0f * sinf(t);
+                quad.bottomRight.y += 30.0f * cosf(t);
+
+                double start = GetTime();
+                RM_SetQuad(surface, quad);
+                RM_DrawSurface(surface);
+                accum += GetTime() - start;
+
+                // Position kernel alone, against per-vertex evaluation of the same quad
+                double kernelMs, referenceMs;
+                float error = RM_CompareMeshKernel(surface, resolutions[current], resolutions[current], &kernelMs, &referenceMs);
+                results[current].kernelMs += kernelMs / DRAG_SAMPLES;
+                results[current].referenceMs += referenceMs / DRAG_SAMPLES;
+                if (error > results[current].kernelError) results[current].kernelError = error;
+
+                if (++sample == DRAG_SAMPLES) {
+                    RM_BufferStats stats = RM_GetBufferStats(surface);
+                    results[current].dragMs = accum * 1000.0 / DRAG_SAMPLES;
+                    results[current].uploadMs = (stats.uploads > 0) ? stats.totalUploadMs / stats.uploads : 0.0;
+                    phase = PHASE_FRAME;
+                    sample = 0;
+                    accum = 0.0;
+                    RM_SetQuad(surface, baseQuad);
+                }
+            } else {
+                RM_DrawSurface(surface);
+
+                if (phase == PHASE_FRAME) {
+                    // Skip the first frame, it still holds the quad update
+                    if (sample > 0) accum += GetFrameTime();
+
+                    if (++sample == FRAME_SAMPLES + 1) {
+                        results[current].frameMs = accum * 1000.0 / FRAME_SAMPLES;
+                        results[current].done = true;
+                        sample = 0;
+                        accum = 0.0;
+
+                        if (++current < RESOLUTION_COUNT) {
+                            phase = PHASE_REBUILD;
+                        } else {
+                            phase = PHASE_DONE;
+                            TraceLog(LOG_INFO, "BENCH: %s, %s, %s buffers",
+                                     (RM_GetMapMode(surface) == RM_MAP_HOMOGRAPHY) ? "HOMOGRAPHY" : "BILINEAR",
+                                     formatNames[format], RM_IsSurfaceDynamic(surface) ? "dynamic" : "static");
+                            for (int i = 0; i < RESOLUTION_COUNT; i++) {
+                                TraceLog(LOG_INFO, "BENCH: %3dx%-3d rebuild %7.3f ms  drag %7.3f ms  upload %7.3f ms  frame %7.3f ms  "
+                                         "kernel %7.3f ms (per-vertex %7.3f ms, %.1fx, max diff %.4f px)",
+                                         results[i].resolution, results[i].resolution, results[i].rebuildMs,
+                                         results[i].dragMs, results[i].uploadMs, results[i].frameMs,
+                                         results[i].kernelMs, results[i].referenceMs,
+                                         (results[i].kernelMs > 0.0) ? results[i].referenceMs / results[i].kernelMs : 0.0,
+                                         results[i].kernelError);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // HUD
+            DrawText("RAYMAP - MESH RESOLUTION BENCHMARK", 10, 10, 20, GREEN);
+            DrawFPS(screenWidth - 100, 10);
+
+            DrawRectangle(10, 50, 1040, 110 + RESOLUTION_COUNT * 24, Fade(BLACK, 0.75f));
+            DrawRectangleLines(10, 50, 1040, 110 + RESOLUTION_COUNT * 24, GREEN);
+
+            DrawText(TextFormat("Mode: %s   Format: %s   Buffers: %s",
+                     (RM_GetMapMode(surface) == RM_MAP_HOMOGRAPHY) ? "HOMOGRAPHY" : "BILINEAR",
+                     formatNames[format], RM_IsSurfaceDynamic(surface) ? "dynamic" : "static"),
+                     20, 60, 18, YELLOW);
+            DrawText("Resolution    Vertices  Draws   Rebuild     Drag   Upload    Frame   Kernel  Speedup  Diff (px)",
+                     20, 90, 16, LIGHTGRAY);
+
+            for (int i = 0; i < RESOLUTION_COUNT; i++) {
+                int res = results[i].resolution;
+                int vertices = (res + 1) * (res + 1);
+                int draws = (vertices > 65535) ? (res + 65535 / (res + 1) - 2) / (65535 / (res + 1) - 1) : 1;
+                Color color = results[i].done ? WHITE : ((i == current) ? YELLOW : DARKGRAY);
+
+                if (results[i].done) {
+                    double speedup = (results[i].kernelMs > 0.0) ? results[i].referenceMs / results[i].kernelMs : 0.0;
+                    DrawText(TextFormat("%4dx%-4d   %9d  %5d  %8.3f %8.3f %8.3f %8.3f %8.3f %7.1fx %9.4f", res, res, vertices, draws,
+                             results[i].rebuildMs, results[i].dragMs, results[i].uploadMs, results[i].frameMs,
+                             results[i].kernelMs, speedup, results[i].kernelError),
+                             20, 115 + i * 24, 16, color);
+                } else {
+                    DrawText(TextFormat("%4dx%-4d   %9d  %5d  %s", res, res, vertices, draws,
+                             (i == current) ? "running..." : "-"), 20, 115 + i * 24, 16, color);
+                }
+            }
+
+            DrawText("[SPACE] Restart  [M] Mode  [F] Format  [D] Dynamic", 20, 125 + RESOLUTION_COUNT * 24, 14, GRAY);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    RM_DestroySurface(surface);
+    CloseWindow();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
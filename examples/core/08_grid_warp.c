@@ -0,0 +1,188 @@
+/*******************************************************************************************
+*
+*   raymap - 08_grid_warp
+*
+*   DESCRIPTION:
+*       Control point grid warping (RM_MAP_GRID) for curved or irregular projection screens.
+*       Drag the quad corners to move the whole lattice, drag any control point to bend the
+*       surface locally. Moving one point only recomputes and uploads the part of the mesh
+*       it affects, the HUD shows the upload count and time of these edits.
+*       The lattice is saved with the quad by RM_SaveConfig().
+*
+*   DEPENDENCIES:
+*       raylib 5.0+
+*       raymap 1.1.0+
+*
+*   COMPILATION (Linux):
+*       gcc 08_grid_warp.c -o 08_grid_warp -lraylib -lm
+*
+*   COMPILATION (macOS):
+*       clang 08_grid_warp.c -o 08_grid_warp -lraylib -framework CoreVideo \
+*             -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL
+*
+*   COMPILATION (Windows - MinGW):
+*       gcc 08_grid_warp.c -o 08_grid_warp.exe -lraylib -lopengl32 -lgdi32 -lwinmm
+*
+*   CONTROLS:
+*       Mouse       - Drag corners (whole lattice) or control points (local bend)
+*       UP/DOWN     - Control point rows (2-16)
+*       LEFT/RIGHT  - Control point columns (2-16)
+*       R           - Reset the control points to the quad
+*       +/-         - Mesh resolution
+*       S           - Save configuration (grid_warp.cfg)
+*       L           - Load configuration
+*       C           - Toggle calibration mode
+*       ESC         - Exit
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2026 grerfou
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYMAP_IMPLEMENTATION
+#include "raymap.h"
+
+#define CONFIG_FILE "grid_warp.cfg"
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1920;
+    const int screenHeight = 1080;
+
+    InitWindow(screenWidth, screenHeight, "RayMap - 08 Grid Warp");
+    SetTargetFPS(60);
+
+    // Create surface
+    RM_Surface *surface = RM_CreateSurface(800, 600, RM_MAP_GRID);
+
+    if (!surface) {
+        TraceLog(LOG_ERROR, "Failed to create surface!");
+        CloseWindow();
+        return -1;
+    }
+
+    RM_Quad quad = {
+        .topLeft = { 360, 140 },
+        .topRight = { 1560, 140 },
+        .bottomRight = { 1560, 940 },
+        .bottomLeft = { 360, 940 }
+    };
+    RM_SetQuad(surface, quad);
+    RM_SetGridSize(surface, 6, 5);
+
+    int meshResolution = 128;
+    RM_SetMeshResolution(surface, meshResolution, meshResolution);
+
+    RM_Calibration calibration = RM_CalibrationDefault(surface);
+
+    // Buffer stats at the last mesh update, to label what triggered it
+    RM_BufferStats lastStats = RM_GetBufferStats(surface);
+    const char *lastEdit = "-";
+
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        //----------------------------------------------------------------------------------
+        // Update
+        //----------------------------------------------------------------------------------
+        RM_UpdateCalibrationInput(&calibration, KEY_C);
+
+        int columns, rows;
+        RM_GetGridSize(surface, &columns, &rows);
+
+        if (IsKeyPressed(KEY_RIGHT) && columns < 16) RM_SetGridSize(surface, columns + 1, rows);
+        if (IsKeyPressed(KEY_LEFT) && columns > 2) RM_SetGridSize(surface, columns - 1, rows);
+        if (IsKeyPressed(KEY_DOWN) && rows < 16) RM_SetGridSize(surface, columns, rows + 1);
+        if (IsKeyPressed(KEY_UP) && rows > 2) RM_SetGridSize(surface, columns, rows - 1);
+        if (IsKeyPressed(KEY_R)) RM_ResetGrid(surface);
+
+        if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+            meshResolution = (meshResolution < 512) ? meshResolution * 2 : 512;
+            RM_SetMeshResolution(surface, meshResolution, meshResolution);
+        }
+        if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+            meshResolution = (meshResolution > 16) ? meshResolution / 2 : 16;
+            RM_SetMeshResolution(surface, meshResolution, meshResolution);
+        }
+
+        if (IsKeyPressed(KEY_S)) RM_SaveConfig(surface, CONFIG_FILE);
+        if (IsKeyPressed(KEY_L)) RM_LoadConfig(surface, CONFIG_FILE);
+
+        RM_GetGridSize(surface, &columns, &rows);
+
+        //----------------------------------------------------------------------------------
+        // Draw to surface
+        //----------------------------------------------------------------------------------
+        RM_BeginSurface(surface);
+            ClearBackground((Color){ 20, 30, 40, 255 });
+
+            for (int x = 0; x <= 16; x++) DrawLine(x * 50, 0, x * 50, 600, ColorAlpha(SKYBLUE, 0.5f));
+            for (int y = 0; y <= 12; y++) DrawLine(0, y * 50, 800, y * 50, ColorAlpha(SKYBLUE, 0.5f));
+
+            DrawCircleLines(400, 300, 200, YELLOW);
+            DrawCircleLines(400, 300, 120, ORANGE);
+            DrawText("GRID WARP", 250, 270, 60, WHITE);
+        RM_EndSurface(surface);
+
+        //----------------------------------------------------------------------------------
+        // Draw to screen
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+            ClearBackground(BLACK);
+
+            RM_DrawSurface(surface);
+
+            // Upload of this frame's mesh update (a control point drag or a full rewrite)
+            RM_BufferStats stats = RM_GetBufferStats(surface);
+            if (stats.uploads != lastStats.uploads) {
+                int active = RM_GetActiveCorner(calibration);
+                lastEdit = (active >= 4) ? "control point" : ((active >= 0) ? "corner" : "rebuild");
+                lastStats = stats;
+            }
+
+            if (calibration.enabled) {
+                RM_DrawCalibration(calibration);
+            }
+
+            // HUD
+            DrawText("RAYMAP - GRID WARP", 10, 10, 20, GREEN);
+            DrawFPS(screenWidth - 100, 10);
+
+            int meshColumns, meshRows;
+            RM_GetMeshResolution(surface, &meshColumns, &meshRows);
+            int vertices = (meshColumns + 1) * (meshRows + 1);
+
+            DrawRectangle(10, 50, 440, 160, Fade(BLACK, 0.7f));
+            DrawRectangleLines(10, 50, 440, 160, GREEN);
+
+            DrawText(TextFormat("Control points: %dx%d", columns, rows), 20, 60, 18, YELLOW);
+            DrawText(TextFormat("Mesh: %dx%d (%d vertices)", meshColumns, meshRows, vertices), 20, 85, 16, WHITE);
+            DrawText(TextFormat("Last update: %s", lastEdit), 20, 110, 16, LIME);
+            DrawText(TextFormat("Uploads: %u   max %.2f ms", stats.uploads, stats.maxUploadMs), 20, 135, 16, SKYBLUE);
+            DrawText(TextFormat("Active: %d", RM_GetActiveCorner(calibration)), 20, 160, 16, LIGHTGRAY);
+
+            DrawText("[ARROWS] Grid  [R] Reset  [+/-] Mesh  [S/L] Save/Load  [C] Calibrate",
+                     20, 185, 14, GRAY);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    RM_DestroySurface(surface);
+    CloseWindow();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
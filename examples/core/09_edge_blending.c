@@ -0,0 +1,207 @@
+/*******************************************************************************************
+*
+*   raymap - 09_edge_blending
+*
+*   DESCRIPTION:
+*       Edge blending of three overlapping projector surfaces. Each surface shows its part of
+*       one wide image, the overlaps are found from the quads and faded in the surface shader
+*       (no mask textures, no extra pass). Overlap polygons are outlined, drag the corners of
+*       the selected surface to see the ramps follow.
+*       The projector gamma sets how the ramp is encoded so that light adds up to 1 in the
+*       overlap. Here both images add up on one monitor, in encoded values: gamma 1.0 looks
+*       seamless on screen, real projectors need their own gamma (2.2 typical).
+*
+*   DEPENDENCIES:
+*       raylib 5.0+
+*       raymap 1.1.0+
+*
+*   COMPILATION (Linux):
+*       gcc 09_edge_blending.c -o 09_edge_blending -lraylib -lm -lpthread
+*
+*   COMPILATION (macOS):
+*       clang 09_edge_blending.c -o 09_edge_blending -lraylib -framework CoreVideo \
+*             -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL
+*
+*   COMPILATION (Windows - MinGW):
+*       gcc 09_edge_blending.c -o 09_edge_blending.exe -lraylib -lopengl32 -lgdi32 -lwinmm
+*
+*   CONTROLS:
+*       Mouse       - Drag corners of the selected surface
+*       TAB         - Select next surface
+*       B           - Toggle edge blending
+*       UP/DOWN     - Projector gamma (1.0-3.0)
+*       LEFT/RIGHT  - Ramp width (0 = whole overlap)
+*       O           - Toggle overlap outlines
+*       C           - Toggle calibration mode
+*       ESC         - Exit
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2026 grerfou
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYMAP_IMPLEMENTATION
+#include "raymap.h"
+
+#define PROJECTOR_COUNT 3
+#define SURFACE_WIDTH 700
+#define SURFACE_HEIGHT 600
+#define PROJECTOR_STEP 550          // Image width covered by each projector alone
+
+// Part of the wide image starting at image x = offset
+static void DrawImagePart(int offset)
+{
+    ClearBackground((Color){ 200, 200, 200, 255 });
+
+    for (int x = 0; x <= SURFACE_WIDTH + PROJECTOR_STEP * 2; x += 50) {
+        DrawLine(x - offset, 0, x - offset, SURFACE_HEIGHT, DARKGRAY);
+    }
+    for (int y = 0; y <= SURFACE_HEIGHT; y += 50) DrawLine(0, y, SURFACE_WIDTH, y, DARKGRAY);
+
+    DrawCircleLines(900 - offset, 300, 250, MAROON);
+    DrawCircle(600 - offset, 300, 80, ColorAlpha(BLUE, 0.6f));
+    DrawCircle(1200 - offset, 300, 80, ColorAlpha(DARKGREEN, 0.6f));
+    DrawText("EDGE BLENDING", 520 - offset, 270, 60, BLACK);
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1920;
+    const int screenHeight = 1080;
+
+    InitWindow(screenWidth, screenHeight, "RayMap - 09 Edge Blending");
+    SetTargetFPS(60);
+
+    // One surface per projector, side by side with 150 px overlaps
+    RM_Surface *surfaces[PROJECTOR_COUNT] = { 0 };
+    RM_Calibration calibrations[PROJECTOR_COUNT];
+    float gamma = 2.2f;
+    float rampWidth = 0.0f;
+
+    for (int i = 0; i < PROJECTOR_COUNT; i++) {
+        surfaces[i] = RM_CreateSurface(SURFACE_WIDTH, SURFACE_HEIGHT, RM_MAP_HOMOGRAPHY);
+        if (!surfaces[i]) {
+            TraceLog(LOG_ERROR, "Failed to create surface!");
+            for (int j = 0; j < i; j++) RM_DestroySurface(surfaces[j]);
+            CloseWindow();
+            return -1;
+        }
+
+        float x = 60.0f + (float)(i * PROJECTOR_STEP);
+        RM_Quad quad = {
+            .topLeft = { x, 240 },
+            .topRight = { x + SURFACE_WIDTH, 240 },
+            .bottomRight = { x + SURFACE_WIDTH, 240 + SURFACE_HEIGHT },
+            .bottomLeft = { x, 240 + SURFACE_HEIGHT }
+        };
+        RM_SetQuad(surfaces[i], quad);
+        RM_SetSurfaceBlend(surfaces[i], gamma);
+
+        calibrations[i] = RM_CalibrationDefault(surfaces[i]);
+
+        // Static image: drawn once
+        RM_BeginSurface(surfaces[i]);
+            DrawImagePart(i * PROJECTOR_STEP);
+        RM_EndSurface(surfaces[i]);
+    }
+
+    int selected = 0;
+    bool blending = true;
+    bool showOverlaps = true;
+    calibrations[selected].enabled = true;
+
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        //----------------------------------------------------------------------------------
+        // Update
+        //----------------------------------------------------------------------------------
+        if (IsKeyPressed(KEY_TAB)) {
+            bool enabled = calibrations[selected].enabled;
+            calibrations[selected].enabled = false;
+            selected = (selected + 1) % PROJECTOR_COUNT;
+            calibrations[selected].enabled = enabled;
+        }
+        RM_UpdateCalibrationInput(&calibrations[selected], KEY_C);
+
+        bool gammaChanged = false;
+        if (IsKeyPressed(KEY_UP) && gamma < 2.95f) { gamma += 0.1f; gammaChanged = true; }
+        if (IsKeyPressed(KEY_DOWN) && gamma > 1.05f) { gamma -= 0.1f; gammaChanged = true; }
+        if (IsKeyPressed(KEY_B)) { blending = !blending; gammaChanged = true; }
+        if (gammaChanged) {
+            for (int i = 0; i < PROJECTOR_COUNT; i++) RM_SetSurfaceBlend(surfaces[i], blending ? gamma : 0.0f);
+        }
+
+        if (IsKeyPressed(KEY_RIGHT)) rampWidth = (rampWidth < 300.0f) ? rampWidth + 25.0f : 300.0f;
+        if (IsKeyPressed(KEY_LEFT)) rampWidth = (rampWidth > 25.0f) ? rampWidth - 25.0f : 0.0f;
+        RM_SetBlendWidth(rampWidth);
+
+        if (IsKeyPressed(KEY_O)) showOverlaps = !showOverlaps;
+
+        //----------------------------------------------------------------------------------
+        // Draw to screen
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+            ClearBackground(BLACK);
+
+            // Overlapping light adds up, as with real projectors
+            BeginBlendMode(BLEND_ADDITIVE);
+                for (int i = 0; i < PROJECTOR_COUNT; i++) RM_DrawSurface(surfaces[i]);
+            EndBlendMode();
+
+            if (showOverlaps) {
+                for (int i = 0; i < PROJECTOR_COUNT; i++) {
+                    for (int j = i + 1; j < PROJECTOR_COUNT; j++) {
+                        Vector2 points[16];
+                        int count = RM_GetSurfaceOverlap(surfaces[i], surfaces[j], points, 16);
+                        if (count > 16) count = 16;
+                        for (int k = 0; k < count; k++) {
+                            DrawLineEx(points[k], points[(k + 1) % count], 2.0f, YELLOW);
+                        }
+                    }
+                }
+            }
+
+            if (calibrations[selected].enabled) {
+                RM_DrawCalibration(calibrations[selected]);
+            }
+
+            // HUD
+            DrawText("RAYMAP - EDGE BLENDING", 10, 10, 20, GREEN);
+            DrawFPS(screenWidth - 100, 10);
+
+            DrawRectangle(10, 50, 520, 160, Fade(BLACK, 0.7f));
+            DrawRectangleLines(10, 50, 520, 160, GREEN);
+
+            DrawText(TextFormat("Blending: %s   Gamma: %.1f", blending ? "ON" : "OFF", gamma), 20, 60, 18, YELLOW);
+            DrawText((rampWidth > 0.0f) ? TextFormat("Ramp width: %.0f px", rampWidth) : "Ramp width: whole overlap",
+                     20, 85, 16, WHITE);
+            DrawText(TextFormat("Selected: projector %d   Overlaps: %d", selected + 1,
+                     RM_GetSurfaceBlendNeighbors(surfaces[selected])), 20, 110, 16, LIME);
+            DrawText("Yellow: overlap polygons", 20, 135, 16, LIGHTGRAY);
+
+            DrawText("[TAB] Select  [B] Blend  [UP/DOWN] Gamma  [LEFT/RIGHT] Ramp  [O] Overlaps  [C] Calibrate",
+                     20, 185, 14, GRAY);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 0; i < PROJECTOR_COUNT; i++) RM_DestroySurface(surfaces[i]);
+    CloseWindow();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+/*******************************************************************************************
+*
+*   raymap - 10_multi_output
+*
+*   DESCRIPTION:
+*       Three projectors driven from one wide window with an output layout. Each output has
+*       its own position in the window and rotation (the middle projector hangs upside down
+*       from the ceiling), and shows its part of one shared wall: neighbours overlap, and the
+*       surfaces crossing an overlap are drawn on both projectors and edge blended.
+*       RM_DrawOutputLayout sets viewport, scissor and projection per output, skips surfaces
+*       that fall outside an output, and everything goes out in one frame.
+*
+*   DEPENDENCIES:
+*       raylib 5.0+
+*       raymap 1.1.0+
+*
+*   COMPILATION (Linux):
+*       gcc 10_multi_output.c -o 10_multi_output -lraylib -lm -lpthread
+*
+*   COMPILATION (macOS):
+*       clang 10_multi_output.c -o 10_multi_output -lraylib -framework CoreVideo \
+*             -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL
+*
+*   COMPILATION (Windows - MinGW):
+*       gcc 10_multi_output.c -o 10_multi_output.exe -lraylib -lopengl32 -lgdi32 -lwinmm
+*
+*   CONTROLS:
+*       Mouse       - Drag corners of the selected surface (over its projector)
+*       TAB         - Select next output
+*       R           - Flip the selected output (0 / 180 degrees)
+*       C           - Toggle calibration mode
+*       ESC         - Exit
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2026 grerfou
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYMAP_IMPLEMENTATION
+#include "raymap.h"
+
+#define OUTPUT_COUNT 3
+#define OUTPUT_WIDTH 640
+#define OUTPUT_HEIGHT 480
+#define OVERLAP 80
+
+// Route the mouse through an output, so that calibration reads the wall (quad space).
+// At 1:1 the mapping is c + p, or c - p for a half turn, with c the image of the window origin
+static void SetOutputMouse(const RM_OutputLayout *layout, int index)
+{
+    Vector2 c = RM_WindowToOutput(layout, index, (Vector2){ 0.0f, 0.0f });
+    if (RM_GetOutput(layout, index).rotation == 180) {
+        SetMouseOffset(-(int)c.x, -(int)c.y);
+        SetMouseScale(-1.0f, -1.0f);
+    } else {
+        SetMouseOffset((int)c.x, (int)c.y);
+        SetMouseScale(1.0f, 1.0f);
+    }
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = OUTPUT_COUNT * OUTPUT_WIDTH;
+    const int screenHeight = OUTPUT_HEIGHT + 120;
+
+    InitWindow(screenWidth, screenHeight, "RayMap - 10 Multi Output");
+    SetTargetFPS(60);
+
+    RM_OutputLayout *layout = RM_CreateOutputLayout();
+    if (!layout) {
+        TraceLog(LOG_ERROR, "Failed to create output layout!");
+        CloseWindow();
+        return -1;
+    }
+
+    // Side by side below the HUD, the middle one upside down. Together they show a wall
+    // with OVERLAP pixels shared by neighbours
+    for (int i = 0; i < OUTPUT_COUNT; i++) {
+        RM_Output output = { i * OUTPUT_WIDTH, 120, OUTPUT_WIDTH, OUTPUT_HEIGHT, (i == 1) ? 180 : 0,
+                             { (float)(i * (OUTPUT_WIDTH - OVERLAP)), 0.0f, OUTPUT_WIDTH, OUTPUT_HEIGHT } };
+        RM_AddOutput(layout, output);
+    }
+    RM_SetBlendWidth(OVERLAP);
+
+    // One surface per projector, quads on the wall: neighbours overlap and blend
+    RM_Surface *surfaces[OUTPUT_COUNT] = { 0 };
+    RM_Calibration calibrations[OUTPUT_COUNT];
+    const Color colors[OUTPUT_COUNT] = { MAROON, DARKGREEN, DARKBLUE };
+
+    for (int i = 0; i < OUTPUT_COUNT; i++) {
+        surfaces[i] = RM_CreateSurface(400, 300, RM_MAP_HOMOGRAPHY);
+        if (!surfaces[i]) {
+            TraceLog(LOG_ERROR, "Failed to create surface!");
+            for (int j = 0; j < i; j++) RM_DestroySurface(surfaces[j]);
+            RM_DestroyOutputLayout(layout);
+            CloseWindow();
+            return -1;
+        }
+
+        float x = (float)(i * (OUTPUT_WIDTH - OVERLAP));
+        RM_Quad quad = {
+            .topLeft = { x, 60 },
+            .topRight = { x + OUTPUT_WIDTH, 50 },
+            .bottomRight = { x + OUTPUT_WIDTH, 430 },
+            .bottomLeft = { x, 420 }
+        };
+        RM_SetQuad(surfaces[i], quad);
+        RM_SetSurfaceBlend(surfaces[i], 2.2f);
+        RM_AssignSurfaceToOutput(layout, surfaces[i], RM_ALL_OUTPUTS);
+
+        calibrations[i] = RM_CalibrationDefault(surfaces[i]);
+        calibrations[i].enabled = false;
+    }
+
+    int selected = 0;
+    calibrations[selected].enabled = true;
+
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        //----------------------------------------------------------------------------------
+        // Update
+        //----------------------------------------------------------------------------------
+        if (IsKeyPressed(KEY_TAB)) {
+            bool enabled = calibrations[selected].enabled;
+            calibrations[selected].enabled = false;
+            selected = (selected + 1) % OUTPUT_COUNT;
+            calibrations[selected].enabled = enabled;
+        }
+
+        if (IsKeyPressed(KEY_R)) {
+            RM_Output output = RM_GetOutput(layout, selected);
+            output.rotation = (output.rotation == 0) ? 180 : 0;
+            RM_SetOutput(layout, selected, output);
+        }
+
+        // Calibration reads the mouse on the wall, through the selected projector
+        SetOutputMouse(layout, selected);
+        RM_UpdateCalibrationInput(&calibrations[selected], KEY_C);
+        SetMouseOffset(0, 0);
+        SetMouseScale(1.0f, 1.0f);
+
+        //----------------------------------------------------------------------------------
+        // Draw to surfaces
+        //----------------------------------------------------------------------------------
+        for (int i = 0; i < OUTPUT_COUNT; i++) {
+            RM_BeginSurface(surfaces[i]);
+                ClearBackground(colors[i]);
+                for (int x = 0; x <= 400; x += 40) DrawLine(x, 0, x, 300, Fade(WHITE, 0.3f));
+                for (int y = 0; y <= 300; y += 40) DrawLine(0, y, 400, y, Fade(WHITE, 0.3f));
+                DrawText(TextFormat("PROJECTOR %d", i + 1), 70, 110, 40, WHITE);
+                DrawText("TOP", 180, 20, 20, YELLOW);
+            RM_EndSurface(surfaces[i]);
+        }
+
+        //----------------------------------------------------------------------------------
+        // Draw to screen
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+            ClearBackground(BLACK);
+
+            // Every output in one pass over the layout
+            RM_DrawOutputLayout(layout);
+
+            // Per-output overlays, on the wall: a handle in an overlap shows on both projectors
+            for (int i = 0; i < OUTPUT_COUNT; i++) {
+                int x = i * (OUTPUT_WIDTH - OVERLAP);
+                RM_BeginOutput(layout, i);
+                    DrawRectangleLines(x, 0, OUTPUT_WIDTH, OUTPUT_HEIGHT, (i == selected) ? YELLOW : DARKGRAY);
+                    DrawText(TextFormat("Output %d", i + 1), x + 10, 10, 20, (i == selected) ? YELLOW : GRAY);
+                    for (int j = 0; j < OUTPUT_COUNT; j++) {
+                        if (calibrations[j].enabled) RM_DrawCalibration(calibrations[j]);
+                    }
+                RM_EndOutput();
+            }
+
+            // HUD
+            RM_Output output = RM_GetOutput(layout, selected);
+            DrawText("RAYMAP - MULTI OUTPUT", 10, 10, 20, GREEN);
+            DrawFPS(screenWidth - 100, 10);
+            DrawText(TextFormat("Selected: output %d   %dx%d at (%d, %d), rotation %d", selected + 1,
+                     output.width, output.height, output.x, output.y, output.rotation), 10, 45, 18, WHITE);
+            DrawText(TextFormat("Surface draws: %d", RM_GetOutputLayoutDrawCount(layout)), 10, 70, 16, LIME);
+            DrawText("[TAB] Select output  [R] Flip output  [C] Calibrate", 10, 95, 14, GRAY);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    for (int i = 0; i < OUTPUT_COUNT; i++) RM_DestroySurface(surfaces[i]);
+    RM_DestroyOutputLayout(layout);
+    CloseWindow();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
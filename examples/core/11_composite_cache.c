@@ -0,0 +1,250 @@
+/*******************************************************************************************
+*
+*   raymap - 11_composite_cache
+*
+*   DESCRIPTION:
+*       A wall of still surfaces with two animated ones on top. The stills go into a
+*       composite cache: they are drawn once into an output-sized texture, and each frame
+*       only draws that texture plus the animated surfaces. The cache is redrawn when a
+*       cached surface moves or gets new content, compare frame times with the cache off.
+*       A translucent banner is cached over the stills: it looks the same with the cache
+*       on and off.
+*
+*   DEPENDENCIES:
+*       raylib 5.0+
+*       raymap 1.1.0+
+*
+*   COMPILATION (Linux):
+*       gcc 11_composite_cache.c -o 11_composite_cache -lraylib -lm -lpthread
+*
+*   COMPILATION (macOS):
+*       clang 11_composite_cache.c -o 11_composite_cache -lraylib -framework CoreVideo \
+*             -framework IOKit -framework Cocoa -framework GLUT -framework OpenGL
+*
+*   COMPILATION (Windows - MinGW):
+*       gcc 11_composite_cache.c -o 11_composite_cache.exe -lraylib -lopengl32 -lgdi32 -lwinmm
+*
+*   CONTROLS:
+*       SPACE       - Toggle composite cache
+*       S           - Shift one still surface (triggers a cache redraw)
+*       R           - Redraw the content of one still surface (triggers a cache redraw)
+*       ESC         - Exit
+*
+*   LICENSE: zlib/libpng
+*
+*   Copyright (c) 2026 grerfou
+*
+********************************************************************************************/
+
+#include "raylib.h"
+
+#define RAYMAP_IMPLEMENTATION
+#include "raymap.h"
+
+#include <math.h>
+
+#define STILL_COLUMNS 10
+#define STILL_ROWS 6
+#define STILL_COUNT (STILL_COLUMNS * STILL_ROWS)
+#define ANIMATED_COUNT 2
+
+// Slightly keystoned tile of the wall
+static RM_Quad StillQuad(int index, float shift)
+{
+    float x = 40.0f + (float)(index % STILL_COLUMNS) * 184.0f + shift;
+    float y = 140.0f + (float)(index / STILL_COLUMNS) * 150.0f;
+    RM_Quad quad = {
+        .topLeft = { x + 6, y },
+        .topRight = { x + 170, y + 4 },
+        .bottomRight = { x + 164, y + 136 },
+        .bottomLeft = { x, y + 132 }
+    };
+    return quad;
+}
+
+// Translucent content: the stills show through the banner
+static void DrawBanner(RM_Surface *surface)
+{
+    RM_BeginSurface(surface);
+        ClearBackground(Fade(SKYBLUE, 0.4f));
+        DrawRectangle(0, 0, 1200, 12, Fade(WHITE, 0.8f));
+        DrawRectangle(0, 188, 1200, 12, Fade(WHITE, 0.8f));
+        DrawText("TRANSLUCENT CACHED BANNER", 170, 70, 60, Fade(WHITE, 0.7f));
+    RM_EndSurface(surface);
+}
+
+static void DrawStill(RM_Surface *surface, int index, int version)
+{
+    RM_BeginSurface(surface);
+        ClearBackground(ColorFromHSV((float)((index * 37 + version * 90) % 360), 0.6f, 0.8f));
+        DrawRectangleLines(4, 4, 248, 184, WHITE);
+        DrawText(TextFormat("%02d", index), 90, 60, 60, WHITE);
+        DrawText(TextFormat("v%d", version), 12, 160, 20, BLACK);
+    RM_EndSurface(surface);
+}
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    // Initialization
+    //--------------------------------------------------------------------------------------
+    const int screenWidth = 1920;
+    const int screenHeight = 1080;
+
+    InitWindow(screenWidth, screenHeight, "RayMap - 11 Composite Cache");
+    SetTargetFPS(0);
+
+    RM_CompositeCache *cache = RM_CreateCompositeCache(screenWidth, screenHeight);
+    if (!cache) {
+        TraceLog(LOG_ERROR, "Failed to create composite cache!");
+        CloseWindow();
+        return -1;
+    }
+
+    // Stills: content drawn once, cached
+    RM_Surface *stills[STILL_COUNT] = { 0 };
+    int versions[STILL_COUNT] = { 0 };
+    bool shifted[STILL_COUNT] = { 0 };
+    for (int i = 0; i < STILL_COUNT; i++) {
+        stills[i] = RM_CreateSurfaceInAtlas(256, 192, RM_MAP_HOMOGRAPHY);
+        if (!stills[i]) {
+            TraceLog(LOG_ERROR, "Failed to create surface!");
+            for (int j = 0; j < i; j++) RM_DestroySurface(stills[j]);
+            RM_DestroyCompositeCache(cache);
+            CloseWindow();
+            return -1;
+        }
+        RM_SetMeshResolution(stills[i], 32, 32);
+        RM_SetQuad(stills[i], StillQuad(i, 0.0f));
+        DrawStill(stills[i], i, 0);
+        RM_AddSurfaceToCompositeCache(cache, stills[i]);
+    }
+
+    // Banner: cached on top of the stills
+    RM_Surface *banner = RM_CreateSurface(1200, 200, RM_MAP_HOMOGRAPHY);
+    if (!banner) {
+        TraceLog(LOG_ERROR, "Failed to create surface!");
+        for (int i = 0; i < STILL_COUNT; i++) RM_DestroySurface(stills[i]);
+        RM_DestroyCompositeCache(cache);
+        CloseWindow();
+        return -1;
+    }
+    RM_Quad bannerQuad = {
+        .topLeft = { 360, 380 },
+        .topRight = { 1560, 340 },
+        .bottomRight = { 1580, 560 },
+        .bottomLeft = { 340, 580 }
+    };
+    RM_SetQuad(banner, bannerQuad);
+    DrawBanner(banner);
+    RM_AddSurfaceToCompositeCache(cache, banner);
+
+    // Animated surfaces: drawn every frame on top of the cache
+    RM_Surface *animated[ANIMATED_COUNT] = { 0 };
+    for (int i = 0; i < ANIMATED_COUNT; i++) {
+        animated[i] = RM_CreateSurface(400, 300, RM_MAP_HOMOGRAPHY);
+        if (!animated[i]) {
+            TraceLog(LOG_ERROR, "Failed to create surface!");
+            for (int j = 0; j < i; j++) RM_DestroySurface(animated[j]);
+            for (int j = 0; j < STILL_COUNT; j++) RM_DestroySurface(stills[j]);
+            RM_DestroySurface(banner);
+            RM_DestroyCompositeCache(cache);
+            CloseWindow();
+            return -1;
+        }
+        RM_SetSurfaceDynamic(animated[i], true);
+    }
+
+    bool useCache = true;
+    int next = 0;
+
+    //--------------------------------------------------------------------------------------
+
+    // Main game loop
+    while (!WindowShouldClose())
+    {
+        //----------------------------------------------------------------------------------
+        // Update
+        //----------------------------------------------------------------------------------
+        float time = (float)GetTime();
+
+        if (IsKeyPressed(KEY_SPACE)) useCache = !useCache;
+
+        if (IsKeyPressed(KEY_S)) {
+            shifted[next] = !shifted[next];
+            RM_SetQuad(stills[next], StillQuad(next, shifted[next] ? 10.0f : 0.0f));
+            next = (next + 1) % STILL_COUNT;
+        }
+        if (IsKeyPressed(KEY_R)) {
+            versions[next]++;
+            DrawStill(stills[next], next, versions[next]);
+            next = (next + 1) % STILL_COUNT;
+        }
+
+        // Two floating panels
+        for (int i = 0; i < ANIMATED_COUNT; i++) {
+            float cx = (float)screenWidth * (0.3f + 0.4f * (float)i) + 200.0f * sinf(time * (0.7f + 0.3f * (float)i));
+            float cy = (float)screenHeight * 0.55f + 150.0f * cosf(time * 0.9f);
+            float a = time * (i ? -0.5f : 0.4f);
+            float c = cosf(a);
+            float s = sinf(a);
+            RM_Quad quad = {
+                .topLeft = { cx + (-200 * c + 150 * s), cy + (-200 * s - 150 * c) },
+                .topRight = { cx + (200 * c + 150 * s), cy + (200 * s - 150 * c) },
+                .bottomRight = { cx + (200 * c - 150 * s), cy + (200 * s + 150 * c) },
+                .bottomLeft = { cx + (-200 * c - 150 * s), cy + (-200 * s + 150 * c) }
+            };
+            RM_SetQuad(animated[i], quad);
+
+            RM_BeginSurface(animated[i]);
+                ClearBackground(i ? DARKBLUE : MAROON);
+                DrawCircle(200 + (int)(120.0f * sinf(time * 3.0f)), 150, 60, YELLOW);
+                DrawText("ANIMATED", 90, 20, 40, WHITE);
+            RM_EndSurface(animated[i]);
+        }
+
+        // Redrawn only if a still moved or got new content
+        if (useCache) RM_UpdateCompositeCache(cache);
+
+        //----------------------------------------------------------------------------------
+        // Draw to screen
+        //----------------------------------------------------------------------------------
+        BeginDrawing();
+            ClearBackground(BLACK);
+
+            if (useCache) {
+                RM_DrawCompositeCache(cache);
+            } else {
+                for (int i = 0; i < STILL_COUNT; i++) RM_DrawSurface(stills[i]);
+                RM_DrawSurface(banner);
+            }
+            for (int i = 0; i < ANIMATED_COUNT; i++) RM_DrawSurface(animated[i]);
+
+            // HUD
+            DrawText("RAYMAP - COMPOSITE CACHE", 10, 10, 20, GREEN);
+            DrawFPS(screenWidth - 100, 10);
+
+            DrawRectangle(10, 40, 560, 85, Fade(BLACK, 0.7f));
+            DrawRectangleLines(10, 40, 560, 85, GREEN);
+            DrawText(TextFormat("Cache: %s   Still surfaces: %d   Frame: %.2f ms", useCache ? "ON" : "OFF",
+                     STILL_COUNT, GetFrameTime() * 1000.0f), 20, 50, 18, YELLOW);
+            DrawText(TextFormat("Cache redraws: %d", RM_GetCompositeCacheRedraws(cache)), 20, 75, 16, LIME);
+            DrawText("[SPACE] Toggle cache  [S] Shift a still  [R] Redraw a still", 20, 100, 14, GRAY);
+
+        EndDrawing();
+        //----------------------------------------------------------------------------------
+    }
+
+    // De-Initialization
+    //--------------------------------------------------------------------------------------
+    RM_DestroyCompositeCache(cache);
+    for (int i = 0; i < STILL_COUNT; i++) RM_DestroySurface(stills[i]);
+    RM_DestroySurface(banner);
+    for (int i = 0; i < ANIMATED_COUNT; i++) RM_DestroySurface(animated[i]);
+    CloseWindow();
+    //--------------------------------------------------------------------------------------
+
+    return 0;
+}
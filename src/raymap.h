@@ -22,6 +22,30 @@
 *           Generates the implementation of the library into the included file.
 *           Should be defined in only ONE .c file to avoid duplication.
 *
+*       #define RAYMAP_NO_SIMD
+*           Disables SSE2/AVX code paths and uses the scalar fallbacks (identical results).
+*
+*       #define RAYMAP_DYNAMIC_SEGMENTS 3
+*           Number of position buffers cycled by dynamic surfaces (see RM_SetSurfaceDynamic).
+*
+*       #define RAYMAP_STALL_THRESHOLD_MS 0.5
+*           Vertex uploads taking longer than this are counted as stalls in RM_BufferStats.
+*
+*       #define RAYMAP_MESH_ERROR_BUDGET 0.5
+*           Default pixel error allowed by RM_MESH_AUTO mesh resolution (see RM_SetMeshErrorBudget).
+*
+*       #define RAYMAP_ATLAS_SIZE 2048
+*           Width and height of the render textures shared by atlas surfaces (see RM_CreateSurfaceInAtlas).
+*
+*       #define RAYMAP_PROXY_RESOLUTION 8
+*           Mesh columns/rows used while a surface is being edited (see RM_SetSurfaceEditing).
+*
+*       #define RAYMAP_WORKER_THREADS 4
+*           Threads started by RM_UpdateSurfaces and warp map bakes, besides the calling thread.
+*
+*       #define RAYMAP_NO_THREADS
+*           Builds meshes and warp maps on the calling thread only (no pthreads/Win32 threads).
+*
 *   LICENSE: zlib/libpng
 *
 *   Copyright (c) 2026 grerfou
@@ -62,12 +86,64 @@ typedef struct {
 // Map mode enumeration
 typedef enum {
     RM_MAP_BILINEAR = 0,    // Simple bilinear interpolation
-    RM_MAP_HOMOGRAPHY       // Perspective-correct homography
+    RM_MAP_HOMOGRAPHY,      // Perspective-correct homography
+    RM_MAP_GRID             // Catmull-Rom patches through a lattice of control points (curved screens)
 } RM_MapMode;
 
+// Mesh resolution picked from the quad distortion (see RM_SetMeshResolution)
+#define RM_MESH_AUTO 0
+
+// Output index of surfaces drawn on every output they overlap (see RM_AssignSurfaceToOutput)
+#define RM_ALL_OUTPUTS -1
+
+// Output index of surfaces not in the layout (see RM_GetSurfaceOutput)
+#define RM_NO_OUTPUT -2
+
+// Mesh vertex layout
+typedef enum {
+    RM_VERTEX_DEFAULT = 0,  // raylib Mesh: xyz + uv + normal floats, 32 bytes in 3 buffers
+    RM_VERTEX_COMPACT,      // Interleaved xy + uv floats, 16 bytes in 1 buffer
+    RM_VERTEX_COMPACT16     // Interleaved xy + uv 16-bit normalized, 8 bytes in 1 buffer
+} RM_VertexFormat;
+
 // Surface structure (opaque pointer pattern)
 typedef struct RM_Surface RM_Surface;
 
+// Surface batch: many surfaces drawn with shared GL state and few draw calls (opaque)
+typedef struct RM_SurfaceBatch RM_SurfaceBatch;
+
+// Warp map: the mapping of many surfaces baked into one lookup texture, composited in one pass (opaque)
+typedef struct RM_WarpMap RM_WarpMap;
+
+// Output layout: window regions driving separate projectors, with the surfaces of each (opaque)
+typedef struct RM_OutputLayout RM_OutputLayout;
+
+// Composite cache: static surfaces rendered once into an output-sized texture, redrawn on change
+typedef struct RM_CompositeCache RM_CompositeCache;
+
+// Output region of the window (see RM_AddOutput)
+typedef struct {
+    int x, y;                       // Top-left corner in the window (framebuffer pixels)
+    int width, height;              // Output resolution, in the output's own orientation
+    int rotation;                   // Clockwise rotation in the window: 0, 90, 180 or 270 degrees
+    Rectangle source;               // Area of the quad space shown, scaled to width x height
+                                    // (empty: x, y, width, height, the window position at 1:1)
+} RM_Output;
+
+// Vertex position upload statistics (see RM_GetBufferStats)
+typedef struct {
+    unsigned int uploads;           // Position buffer updates sent to the GPU
+    unsigned int stalls;            // Updates that blocked longer than RAYMAP_STALL_THRESHOLD_MS
+    float maxUploadMs;              // Slowest update
+    float totalUploadMs;            // Sum of all update times
+} RM_BufferStats;
+
+// Content pass statistics (see RM_GetContentStats)
+typedef struct {
+    unsigned int rendered;          // Content passes drawn (RM_EndSurface calls)
+    unsigned int skipped;           // Passes skipped (RM_SurfaceNeedsRedraw returned false)
+} RM_ContentStats;
+
 // Calibration visual configuration
 typedef struct {
     bool showCorners;               // Display corner handles
@@ -98,6 +174,9 @@ typedef struct {
 // Create a new mappable surface
 RMAPI RM_Surface *RM_CreateSurface(int width, int height, RM_MapMode mode);
 
+// Create a surface rendering into a region of a shared atlas render texture (small surfaces)
+RMAPI RM_Surface *RM_CreateSurfaceInAtlas(int width, int height, RM_MapMode mode);
+
 // Destroy surface and free resources
 RMAPI void RM_DestroySurface(RM_Surface *surface);
 
@@ -110,12 +189,30 @@ RMAPI RM_Quad RM_GetQuad(const RM_Surface *surface);
 // Get surface render texture dimensions
 RMAPI void RM_GetSurfaceSize(const RM_Surface *surface, int *width, int *height);
 
-// Set mesh resolution (columns x rows)
+// Check if surface renders into an atlas region
+RMAPI bool RM_IsSurfaceInAtlas(const RM_Surface *surface);
+
+// Get surface render texture region in texture pixels (whole texture if not in an atlas)
+RMAPI Rectangle RM_GetSurfaceTextureRect(const RM_Surface *surface);
+
+// Set mesh resolution (columns x rows, or RM_MESH_AUTO)
 RMAPI void RM_SetMeshResolution(RM_Surface *surface, int columns, int rows);
 
-// Get current mesh resolution
+// Get current mesh resolution (the picked one with RM_MESH_AUTO)
 RMAPI void RM_GetMeshResolution(const RM_Surface *surface, int *columns, int *rows);
 
+// Set maximum mesh deviation from the exact mapping used by RM_MESH_AUTO (pixels)
+RMAPI void RM_SetMeshErrorBudget(RM_Surface *surface, float pixels);
+
+// Get RM_MESH_AUTO pixel error budget
+RMAPI float RM_GetMeshErrorBudget(const RM_Surface *surface);
+
+// Set mesh vertex layout (compact formats cut mesh VRAM and upload bandwidth)
+RMAPI void RM_SetVertexFormat(RM_Surface *surface, RM_VertexFormat format);
+
+// Get current mesh vertex layout
+RMAPI RM_VertexFormat RM_GetVertexFormat(const RM_Surface *surface);
+
 //--------------------------------------------------------------------------------------------
 // Rendering
 //--------------------------------------------------------------------------------------------
@@ -123,19 +220,268 @@ RMAPI void RM_GetMeshResolution(const RM_Surface *surface, int *columns, int *ro
 // Begin drawing to surface render texture
 RMAPI void RM_BeginSurface(RM_Surface *surface);
 
-// End drawing to surface render texture
+// End drawing to surface render texture (the content is up to date afterwards)
 RMAPI void RM_EndSurface(RM_Surface *surface);
 
+// Begin drawing to a region of the surface only (surface pixels), the rest of the texture is kept.
+// The region drawn is the union of dirty and the regions marked since the last RM_EndSurface
+RMAPI void RM_BeginSurfaceRegion(RM_Surface *surface, Rectangle dirty);
+
+// Flag the surface content as changed, the next RM_SurfaceNeedsRedraw returns true
+RMAPI void RM_MarkSurfaceDirty(RM_Surface *surface);
+
+// Flag a region of the surface content as changed (surface pixels)
+RMAPI void RM_MarkSurfaceRegionDirty(RM_Surface *surface, Rectangle region);
+
+// Get the bounds of the content changed since the last RM_EndSurface (empty if none)
+RMAPI Rectangle RM_GetSurfaceDirtyRegion(const RM_Surface *surface);
+
+// Check if the content changed since the last RM_EndSurface (false counts as a skipped pass)
+RMAPI bool RM_SurfaceNeedsRedraw(RM_Surface *surface);
+
+// Get content pass statistics (rendered and skipped passes)
+RMAPI RM_ContentStats RM_GetContentStats(const RM_Surface *surface);
+
+// Reset content pass statistics
+RMAPI void RM_ResetContentStats(RM_Surface *surface);
+
 // Draw the warped surface to screen
 // Note: Not const because it may trigger lazy mesh update
 RMAPI void RM_DrawSurface(RM_Surface *surface);
 
+// Bring the meshes of many surfaces up to date at once: vertex data is computed on worker
+// threads, only the GPU uploads run on the calling (render) thread
+RMAPI void RM_UpdateSurfaces(RM_Surface **surfaces, int count);
+
 // Set mapping mode (bilinear/homography)
 RMAPI void RM_SetMapMode(RM_Surface *surface, RM_MapMode mode);
 
 // Get current mapping mode
 RMAPI RM_MapMode RM_GetMapMode(const RM_Surface *surface);
 
+// Stream vertex positions through a ring of buffers (for quads animated every frame)
+RMAPI void RM_SetSurfaceDynamic(RM_Surface *surface, bool dynamic);
+
+// Check if surface streams its vertex positions
+RMAPI bool RM_IsSurfaceDynamic(const RM_Surface *surface);
+
+// Build a coarse proxy mesh while the quad is edited interactively, full mesh once editing ends
+// (calibration sets it while a corner is dragged)
+RMAPI void RM_SetSurfaceEditing(RM_Surface *surface, bool editing);
+
+// Check if surface is drawn with the proxy mesh
+RMAPI bool RM_IsSurfaceEditing(const RM_Surface *surface);
+
+// Get vertex upload statistics (uploads, stalls, timings)
+RMAPI RM_BufferStats RM_GetBufferStats(const RM_Surface *surface);
+
+// Reset vertex upload statistics
+RMAPI void RM_ResetBufferStats(RM_Surface *surface);
+
+// Warp in a vertex shader: static unit grid, quad changes only update uniforms
+// (not available in RM_MAP_GRID mode, the CPU mesh is used)
+RMAPI void RM_SetSurfaceGPUWarp(RM_Surface *surface, bool enabled);
+
+// Check if surface warps on the GPU (false if the warp shader is unavailable)
+RMAPI bool RM_IsSurfaceGPUWarp(const RM_Surface *surface);
+
+//--------------------------------------------------------------------------------------------
+// Control Point Grid (RM_MAP_GRID)
+//--------------------------------------------------------------------------------------------
+
+// Set the control lattice size in points per axis (2-64), resampled from the current warp
+RMAPI bool RM_SetGridSize(RM_Surface *surface, int columns, int rows);
+
+// Get the control lattice size (0 if the surface has no lattice yet)
+RMAPI void RM_GetGridSize(const RM_Surface *surface, int *columns, int *rows);
+
+// Move one control point (screen space), only the mesh region it affects is updated
+RMAPI bool RM_SetGridPoint(RM_Surface *surface, int column, int row, Vector2 position);
+
+// Get one control point position
+RMAPI Vector2 RM_GetGridPoint(const RM_Surface *surface, int column, int row);
+
+// Put every control point back on the quad (flat lattice)
+RMAPI void RM_ResetGrid(RM_Surface *surface);
+
+//--------------------------------------------------------------------------------------------
+// Surface Batching
+//--------------------------------------------------------------------------------------------
+
+// Create an empty surface batch
+RMAPI RM_SurfaceBatch *RM_CreateSurfaceBatch(void);
+
+// Destroy batch (surfaces are not destroyed)
+RMAPI void RM_DestroySurfaceBatch(RM_SurfaceBatch *batch);
+
+// Add surface to batch (returns false if already in it or on allocation failure)
+RMAPI bool RM_AddSurfaceToBatch(RM_SurfaceBatch *batch, RM_Surface *surface);
+
+// Remove surface from batch (call before destroying a batched surface)
+RMAPI void RM_RemoveSurfaceFromBatch(RM_SurfaceBatch *batch, RM_Surface *surface);
+
+// Draw all batched surfaces, in insertion order
+RMAPI void RM_DrawSurfaceBatch(RM_SurfaceBatch *batch);
+
+// Get draw calls issued by the last RM_DrawSurfaceBatch
+RMAPI int RM_GetSurfaceBatchDrawCalls(const RM_SurfaceBatch *batch);
+
+//--------------------------------------------------------------------------------------------
+// Visibility Culling
+//--------------------------------------------------------------------------------------------
+
+// Set output viewports in screen space (count 0 disables culling, the default)
+RMAPI void RM_SetOutputViewports(const Rectangle *viewports, int count);
+
+// Check if surface quad overlaps an output viewport and has a non-zero area
+RMAPI bool RM_IsSurfaceVisible(const RM_Surface *surface);
+
+// Visibility of many surfaces at once (visible may be NULL), returns visible count
+RMAPI int RM_CullSurfaces(RM_Surface *const *surfaces, int count, bool *visible);
+
+//--------------------------------------------------------------------------------------------
+// Edge Blending
+//--------------------------------------------------------------------------------------------
+
+// Blend surface with the other blended surfaces its quad overlaps, for a projector with this
+// gamma (2.2 typical, 0 disables). Ramps are applied by the surface shader, no extra pass
+RMAPI void RM_SetSurfaceBlend(RM_Surface *surface, float gamma);
+
+// Get surface blend gamma (0 if not blended)
+RMAPI float RM_GetSurfaceBlend(const RM_Surface *surface);
+
+// Set blend ramp width in screen pixels (0, the default: ramps span the whole overlap)
+RMAPI void RM_SetBlendWidth(float pixels);
+
+// Get blend ramp width
+RMAPI float RM_GetBlendWidth(void);
+
+// Get the overlap polygon of two surface quads in screen space (points may be NULL),
+// returns its point count (0 if they do not overlap)
+RMAPI int RM_GetSurfaceOverlap(const RM_Surface *a, const RM_Surface *b, Vector2 *points, int maxPoints);
+
+// Get the number of blended surfaces overlapping a blended surface
+RMAPI int RM_GetSurfaceBlendNeighbors(RM_Surface *surface);
+
+//--------------------------------------------------------------------------------------------
+// Warp Map
+//--------------------------------------------------------------------------------------------
+
+// Create an empty warp map covering the output area (0, 0, width, height), one texel per pixel
+RMAPI RM_WarpMap *RM_CreateWarpMap(int width, int height);
+
+// Destroy warp map (surfaces are not destroyed)
+RMAPI void RM_DestroyWarpMap(RM_WarpMap *map);
+
+// Add surface to warp map, on top of the surfaces already in it. Returns false if already in it,
+// on allocation failure or past 7 distinct textures (atlas surfaces of one page share one)
+RMAPI bool RM_AddSurfaceToWarpMap(RM_WarpMap *map, RM_Surface *surface);
+
+// Remove surface from warp map (call before destroying a surface in a warp map)
+RMAPI void RM_RemoveSurfaceFromWarpMap(RM_WarpMap *map, RM_Surface *surface);
+
+// Rebake the table where quads changed since the last bake (called by RM_DrawWarpMap)
+RMAPI void RM_UpdateWarpMap(RM_WarpMap *map);
+
+// Draw all surfaces of the warp map with one full-screen pass
+RMAPI void RM_DrawWarpMap(RM_WarpMap *map);
+
+// Get the lookup table: RGB32F, (s, t, texture slot + 1) of the surface texture per pixel, 0 if none
+RMAPI Texture2D RM_GetWarpMapTexture(const RM_WarpMap *map);
+
+// Get the number of table bakes so far (full or partial)
+RMAPI int RM_GetWarpMapBakes(const RM_WarpMap *map);
+
+//--------------------------------------------------------------------------------------------
+// Output Layout
+//--------------------------------------------------------------------------------------------
+
+// Create an empty output layout
+RMAPI RM_OutputLayout *RM_CreateOutputLayout(void);
+
+// Destroy output layout (surfaces are not destroyed)
+RMAPI void RM_DestroyOutputLayout(RM_OutputLayout *layout);
+
+// Add an output to the layout, returns its index (-1 if invalid or past 16 outputs)
+RMAPI int RM_AddOutput(RM_OutputLayout *layout, RM_Output output);
+
+// Move, resize or rotate an output
+RMAPI bool RM_SetOutput(RM_OutputLayout *layout, int index, RM_Output output);
+
+// Get an output (zeroed if out of range)
+RMAPI RM_Output RM_GetOutput(const RM_OutputLayout *layout, int index);
+
+// Get the number of outputs
+RMAPI int RM_GetOutputCount(const RM_OutputLayout *layout);
+
+// Assign surface to an output, or RM_ALL_OUTPUTS (moves it if assigned). Quads stay in the
+// shared quad space, each output shows its source rectangle of it
+RMAPI bool RM_AssignSurfaceToOutput(RM_OutputLayout *layout, RM_Surface *surface, int output);
+
+// Remove surface from the layout (call before destroying a surface in a layout)
+RMAPI void RM_RemoveSurfaceFromLayout(RM_OutputLayout *layout, RM_Surface *surface);
+
+// Get the output a surface is assigned to (RM_ALL_OUTPUTS if all, RM_NO_OUTPUT if not in the layout)
+RMAPI int RM_GetSurfaceOutput(const RM_OutputLayout *layout, const RM_Surface *surface);
+
+// Draw every output: viewport, scissor and projection of each, then its visible surfaces
+RMAPI void RM_DrawOutputLayout(RM_OutputLayout *layout);
+
+// Get the number of surface draws of the last RM_DrawOutputLayout (culled ones excluded)
+RMAPI int RM_GetOutputLayoutDrawCount(const RM_OutputLayout *layout);
+
+// Begin drawing through an output: quad space coordinates land on its source rectangle
+// (calibration overlays, per-output content). Top level only: not inside BeginScissorMode
+// or a custom viewport, which RM_EndOutput cannot restore
+RMAPI void RM_BeginOutput(const RM_OutputLayout *layout, int index);
+
+// End drawing in an output: restores the projection and modelview, viewport back to the full
+// render target (the window, or the render texture in texture mode) and scissor test off
+RMAPI void RM_EndOutput(void);
+
+// Convert a window point (mouse position) on an output to quad space
+RMAPI Vector2 RM_WindowToOutput(const RM_OutputLayout *layout, int index, Vector2 point);
+
+// Convert a quad space point to window coordinates through an output
+RMAPI Vector2 RM_OutputToWindow(const RM_OutputLayout *layout, int index, Vector2 point);
+
+//--------------------------------------------------------------------------------------------
+// Composite Cache
+//--------------------------------------------------------------------------------------------
+
+// Create an empty composite cache covering the output area (0, 0, width, height)
+RMAPI RM_CompositeCache *RM_CreateCompositeCache(int width, int height);
+
+// Destroy composite cache (surfaces are not destroyed)
+RMAPI void RM_DestroyCompositeCache(RM_CompositeCache *cache);
+
+// Add a static surface to the cache, on top of the surfaces already in it
+// (returns false if already in it or on allocation failure)
+RMAPI bool RM_AddSurfaceToCompositeCache(RM_CompositeCache *cache, RM_Surface *surface);
+
+// Remove surface from the cache (call before destroying a cached surface)
+RMAPI void RM_RemoveSurfaceFromCompositeCache(RM_CompositeCache *cache, RM_Surface *surface);
+
+// Redraw the cached surfaces if a quad, mapping, mesh resolution or content changed since the
+// last redraw. Call outside BeginDrawing, after the content passes (like RM_BeginSurface)
+RMAPI void RM_UpdateCompositeCache(RM_CompositeCache *cache);
+
+// Composite the cached surfaces additively, like overlapping projector light (default: alpha)
+RMAPI void RM_SetCompositeCacheAdditive(RM_CompositeCache *cache, bool additive);
+
+// Force a redraw on next update (changes the cache cannot see: shaders, texture filters...)
+RMAPI void RM_InvalidateCompositeCache(RM_CompositeCache *cache);
+
+// Draw the cached composite, one textured quad whatever the number of cached surfaces
+// (sets its own blend mode, leaves BLEND_ALPHA)
+RMAPI void RM_DrawCompositeCache(const RM_CompositeCache *cache);
+
+// Get the composite texture (render texture: stored upside down, premultiplied alpha)
+RMAPI Texture2D RM_GetCompositeCacheTexture(const RM_CompositeCache *cache);
+
+// Get the number of redraws so far
+RMAPI int RM_GetCompositeCacheRedraws(const RM_CompositeCache *cache);
+
 //--------------------------------------------------------------------------------------------
 // Calibration
 //--------------------------------------------------------------------------------------------
@@ -170,7 +516,7 @@ RMAPI void RM_ResetCalibrationQuad(RM_Calibration *calibration, int screenWidth,
 // Reset surface quad to centered rectangle
 RMAPI void RM_ResetQuad(RM_Surface *surface, int screenWidth, int screenHeight);
 
-// Get active corner index (-1 if none)
+// Get active handle: corner 0-3, control point 4 + (row * columns + column), -1 if none
 RMAPI int RM_GetActiveCorner(RM_Calibration calibration);
 
 // Check if currently dragging a corner
@@ -202,15 +548,26 @@ RMAPI Vector2 RM_GetQuadCenter(RM_Quad quad);
 // Calculate area of quad
 RMAPI float RM_GetQuadArea(RM_Quad quad);
 
+// Compute unit-square -> quad homographies for many quads at once
+// Writes 9 floats per quad (row-major 3x3) to matrices, returns count of non-degenerate quads
+RMAPI int RM_ComputeHomographies(const RM_Quad *quads, int count, float *matrices);
+
 //--------------------------------------------------------------------------------------------
-// Point Mapping
+// Point Mapping (lock-free, callable from any thread while the render thread moves the quad
+// or the RM_MAP_GRID control points)
 //--------------------------------------------------------------------------------------------
 
 // Map point from texture space [0,1] to screen space
-RMAPI Vector2 RM_MapPoint(RM_Surface *surface, Vector2 texturePoint);
+RMAPI Vector2 RM_MapPoint(const RM_Surface *surface, Vector2 texturePoint);
 
 // Map point from screen space to texture space [0,1]
-RMAPI Vector2 RM_UnmapPoint(RM_Surface *surface, Vector2 screenPoint);
+RMAPI Vector2 RM_UnmapPoint(const RM_Surface *surface, Vector2 screenPoint);
+
+// Map array of points from texture space to screen space (same results as RM_MapPoint)
+RMAPI void RM_MapPoints(const RM_Surface *surface, const Vector2 *texturePoints, Vector2 *screenPoints, int count);
+
+// Map array of points from screen space to texture space (same results as RM_UnmapPoint)
+RMAPI void RM_UnmapPoints(const RM_Surface *surface, const Vector2 *screenPoints, Vector2 *texturePoints, int count);
 
 //--------------------------------------------------------------------------------------------
 // Advanced/Debug
@@ -219,6 +576,15 @@ RMAPI Vector2 RM_UnmapPoint(RM_Surface *surface, Vector2 screenPoint);
 #ifdef RAYMAP_DEBUG
 // Get internal mesh for debugging (do NOT modify or free)
 RMAPI Mesh *RM_GetSurfaceMesh(RM_Surface *surface);
+
+// Time the mesh position kernel against per-vertex evaluation on a columns x rows grid
+// (times may be NULL), returns the largest position difference in pixels (-1 on error)
+RMAPI float RM_CompareMeshKernel(const RM_Surface *surface, int columns, int rows, double *kernelMs, double *referenceMs);
+
+// Check RM_ComputeHomographies against the 8x8 DLT system solved in double by Gaussian elimination,
+// on 9x9 points per quad. Returns the largest closed-form difference in pixels (-1 on error).
+// gaussError receives the same for the former float Gauss solver (outputs may be NULL)
+RMAPI float RM_CompareHomographies(const RM_Quad *quads, int count, float *gaussError, double *closedFormMs, double *gaussMs);
 #endif
 
 #endif // RAYMAP_H
@@ -239,9 +605,79 @@ RMAPI Mesh *RM_GetSurfaceMesh(RM_Surface *surface);
 // Implementation Includes
 //--------------------------------------------------------------------------------------------
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
+#include <float.h>
+
+// SIMD paths, AVX is picked up when compiled with -mavx/-mavx2 (RAYMAP_NO_SIMD forces scalar)
+#if !defined(RAYMAP_NO_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+        #define RM_SIMD_SSE2
+        #include <emmintrin.h>
+    #endif
+    #if defined(__AVX__)
+        #define RM_SIMD_AVX
+        #include <immintrin.h>
+    #endif
+#endif
+
+// Memory ordering for the transform seqlock (single writer, lock-free readers)
+#if defined(__GNUC__) || defined(__clang__)
+    #define RM_SEQ_LOAD(p)          __atomic_load_n((p), __ATOMIC_RELAXED)
+    #define RM_SEQ_STORE(p, v)      __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+    #define RM_SEQ_FENCE_ACQUIRE()  __atomic_thread_fence(__ATOMIC_ACQUIRE)
+    #define RM_SEQ_FENCE_RELEASE()  __atomic_thread_fence(__ATOMIC_RELEASE)
+#elif defined(_MSC_VER)
+    #include <intrin.h>
+    #define RM_SEQ_LOAD(p)          (*(const volatile unsigned int *)(p))
+    #define RM_SEQ_STORE(p, v)      (*(volatile unsigned int *)(p) = (v))
+    #if defined(_M_ARM64)
+        #define RM_SEQ_FENCE_ACQUIRE()  __dmb(_ARM64_BARRIER_ISH)
+        #define RM_SEQ_FENCE_RELEASE()  __dmb(_ARM64_BARRIER_ISH)
+    #else
+        // x86/x64 never reorder load-load or store-store, a compiler barrier is enough
+        #define RM_SEQ_FENCE_ACQUIRE()  _ReadWriteBarrier()
+        #define RM_SEQ_FENCE_RELEASE()  _ReadWriteBarrier()
+    #endif
+#else
+    // Unknown compiler: volatile accesses only, concurrent readers are not guaranteed safe
+    #define RM_SEQ_LOAD(p)          (*(const volatile unsigned int *)(p))
+    #define RM_SEQ_STORE(p, v)      (*(volatile unsigned int *)(p) = (v))
+    #define RM_SEQ_FENCE_ACQUIRE()
+    #define RM_SEQ_FENCE_RELEASE()
+#endif
+
+#if defined(RM_SIMD_SSE2)
+    #define RM_SEQ_PAUSE()          _mm_pause()
+#else
+    #define RM_SEQ_PAUSE()
+#endif
+
+// Worker threads of RM_UpdateSurfaces (serial without RM_THREADS)
+#if !defined(RAYMAP_NO_THREADS) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+    #define RM_THREADS
+    #if defined(__GNUC__) || defined(__clang__)
+        #define RM_ATOMIC_FETCH_ADD(p, v)   __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+    #else
+        #define RM_ATOMIC_FETCH_ADD(p, v)   _InterlockedExchangeAdd((volatile long *)(p), (v))
+    #endif
+    #if defined(_WIN32)
+        // Not <windows.h>: it clashes with raylib names (Rectangle, CloseWindow, DrawText...)
+        #include <process.h>
+        #if defined(__cplusplus)
+        extern "C" {
+        #endif
+        __declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long milliseconds);
+        __declspec(dllimport) int __stdcall CloseHandle(void *handle);
+        #if defined(__cplusplus)
+        }
+        #endif
+    #else
+        #include <pthread.h>
+    #endif
+#endif
 
 //--------------------------------------------------------------------------------------------
 // Memory Management Macros
@@ -256,31 +692,232 @@ RMAPI Mesh *RM_GetSurfaceMesh(RM_Surface *surface);
     #define RMFREE(p)           free(p)
 #endif
 
+//--------------------------------------------------------------------------------------------
+// Configuration Defaults
+//--------------------------------------------------------------------------------------------
+#ifndef RAYMAP_DYNAMIC_SEGMENTS
+    #define RAYMAP_DYNAMIC_SEGMENTS     3
+#endif
+#ifndef RAYMAP_STALL_THRESHOLD_MS
+    #define RAYMAP_STALL_THRESHOLD_MS   0.5
+#endif
+#ifndef RAYMAP_MESH_ERROR_BUDGET
+    #define RAYMAP_MESH_ERROR_BUDGET    0.5f
+#endif
+#ifndef RAYMAP_ATLAS_SIZE
+    #define RAYMAP_ATLAS_SIZE           2048
+#endif
+#ifndef RAYMAP_PROXY_RESOLUTION
+    #define RAYMAP_PROXY_RESOLUTION     8
+#endif
+#ifndef RAYMAP_WORKER_THREADS
+    #define RAYMAP_WORKER_THREADS       4
+#endif
+
 //--------------------------------------------------------------------------------------------
 // Internal Types and Structures
 //--------------------------------------------------------------------------------------------
 
 #define RM_EPSILON 1e-4f
+#define RM_MAX_MESH_RESOLUTION 512  // Columns/rows limit of RM_SetMeshResolution
+#define RM_MAX_AUTO_RESOLUTION 64   // Columns/rows limit of RM_MESH_AUTO
+#define RM_BATCH_MAX_TEXTURES 8     // Surface textures per batch draw call (GLES2 minimum texture units)
+#define RM_ATLAS_PADDING 2          // Texels between atlas regions (no filtering bleed)
+#define RM_ATLAS_MAX_FREE 64        // Released regions kept for reuse per atlas page
+#define RM_MAX_OUTPUT_VIEWPORTS 16  // Viewports tested by visibility culling, outputs per layout
+#define RM_MAX_GRID_POINTS 64       // Control points per axis of RM_MAP_GRID
+#define RM_MAX_BLEND_NEIGHBORS 4    // Overlapping surfaces blended per surface (shader varyings)
+#define RM_BLEND_MIN_OVERLAP 1.0f   // Overlap area (pixels) below which quads only touch
+#define RM_WARP_MAP_MAX_TEXTURES 7  // Surface textures per warp map (the table takes the 8th unit)
+#define RM_WARP_BAKE_ROWS 32        // Warp map table rows baked per worker job
+#define RM_DEFAULT_GRID_POINTS 4    // Control points per axis when a surface enters RM_MAP_GRID
+#define RM_GRID_UNMAP_TOLERANCE 0.05f // Newton residual (pixels) accepted by grid unmapping
+#define RM_INVBILINEAR_TOLERANCE 1e-3f
+#define RM_ATTRIB_POSITION 0        // Vertex position location used by UploadMesh
+#define RM_ATTRIB_TEXCOORD 1        // Vertex texcoord location used by UploadMesh
+#define RM_GL_UNSIGNED_SHORT 0x1403 // GL_UNSIGNED_SHORT (not exported by rlgl)
+#define RM_MESH_BUFFER_INDICES 6    // Mesh.vboId slot of the index buffer
+
+// rlSetVertexAttribute() takes the buffer offset as a pointer before raylib 5.5
+#if defined(RAYLIB_VERSION_MAJOR) && ((RAYLIB_VERSION_MAJOR > 5) || (RAYLIB_VERSION_MAJOR == 5 && RAYLIB_VERSION_MINOR >= 5))
+    #define RM_ATTRIB_OFFSET(offset) ((int)(offset))
+#else
+    #define RM_ATTRIB_OFFSET(offset) ((const void *)(size_t)(offset))
+#endif
 
 // 3x3 Matrix for homography transformations
 typedef struct {
     float m[3][3];
 } Matrix3x3;
 
+// Cached inverse bilinear coefficients (see rm_GetInverseBilinear)
+typedef struct {
+    Vector2 a;                      // Top-left corner
+    Vector2 e, f, g;                // u edge, v edge, twist term
+    float kEF;                      // cross(e, f)
+    float k2x4;                     // 4 * cross(g, f)
+    float invK2;                    // 1 / cross(g, f)
+} rm_InvBilinear;
+
+// Per-edge data for the point-in-quad test (same math as rm_SameSide against the center)
+typedef struct {
+    float ax[4], ay[4];             // Edge start
+    float abx[4], aby[4];           // Edge vector
+    float refCross[4];              // Cross product of the edge with the quad center
+} rm_QuadEdges;
+
+// Compact vertex layouts (see RM_VertexFormat)
+typedef struct {
+    float x, y;                     // Screen position
+    float u, v;                     // Texture coordinates
+} rm_VertexCompact;
+
+typedef struct {
+    unsigned short x, y;            // Position normalized to the mesh bounds
+    unsigned short u, v;            // Normalized texture coordinates
+} rm_VertexCompact16;
+
+// Row band of a mesh too large for 16-bit indices (rlgl only draws unsigned short indices):
+// a VAO reading the shared vertex buffer from the band's first vertex, drawn with the
+// index buffer of a (cols, bandRows) grid
+typedef struct {
+    unsigned int vaoId;
+    int firstVertex;
+    struct rm_IndexBuffer *indexBuffer;
+} rm_MeshBand;
+
+// Interleaved mesh used instead of the raylib Mesh by compact formats
+typedef struct {
+    unsigned int vaoId;             // Vertex array (0 without VAO support)
+    unsigned int vboId;             // Interleaved vertex buffer
+    unsigned int eboId;             // Index buffer (shared, owned by the index cache)
+    void *vertices;                 // CPU copy of the vertex buffer
+    float *positions;               // Float positions before 16-bit encoding (COMPACT16 only)
+    int vertexCount;
+    int indexCount;
+    int stride;                     // Bytes per vertex
+    Rectangle bounds;               // Position decode rectangle (COMPACT16 only)
+    rm_MeshBand *bands;             // Row bands (NULL if the mesh fits 16-bit indices)
+    int bandCount;
+    RM_VertexFormat format;         // RM_VERTEX_COMPACT or RM_VERTEX_COMPACT16
+} rm_CompactMesh;
+
+// CPU half of a mesh rebuild: vertex data filled by rm_PrepareMesh (any thread),
+// uploaded and swapped in by rm_CommitMesh (render thread)
+typedef struct {
+    int cols;
+    int rows;
+    RM_VertexFormat format;         // Layout being built
+    Mesh mesh;                      // RM_VERTEX_DEFAULT vertex arrays
+    rm_CompactMesh compact;         // Compact formats, no GPU buffers yet
+    bool ready;                     // Vertex data complete
+} rm_MeshBuild;
+
+// Grid index buffer shared by every mesh with the same resolution (see rm_AcquireIndexBuffer)
+typedef struct rm_IndexBuffer {
+    int cols, rows;                 // Grid resolution (cache key)
+    unsigned int eboId;             // GPU index buffer
+    unsigned short *indices;        // CPU copy (DrawMesh draws indexed when mesh.indices is set)
+    int indexCount;
+    int refCount;                   // Meshes using this buffer
+    unsigned int gridVaoId;         // Unit (u, v) grid for GPU warp (created on first use)
+    unsigned int gridVboId;
+    struct rm_IndexBuffer *next;
+} rm_IndexBuffer;
+
+// Control point lattice of RM_MAP_GRID (kept when leaving the mode, moved along with the quad)
+typedef struct {
+    Vector2 *points;                // columns x rows points, row-major, screen space (NULL if none)
+    int columns;                    // Points per axis
+    int rows;
+    float curvatureU;               // Largest second derivative per span along u (RM_MESH_AUTO)
+    float curvatureV;               // Same along v
+    Rectangle bounds;               // Spline surface bounds (visibility culling, warp maps)
+    int dirtyMinX, dirtyMinY;       // Points moved since the last mesh update (min > max: none)
+    int dirtyMaxX, dirtyMaxY;
+} rm_ControlGrid;
+
+// Catmull-Rom weights of the 4 control points around one parameter value. End spans use
+// mirrored phantom points (2 P0 - P1), folded into the real ones so indices stay in range
+typedef struct {
+    int index[4];
+    float w[4];
+} rm_SplineSpan;
+
+// Point mapping transform, rebuilt once per quad/mode change and published through the
+// surface seqlock. Field order matters: forward data is [quad, edges), inverse data is [mode, end)
+typedef struct {
+    RM_Quad quad;                   // Corner positions
+    Matrix3x3 homography;           // Forward homography (identity in bilinear mode)
+    RM_MapMode mode;                // Mapping algorithm
+    int gridColumns;                // Size of the published control lattice (0 if none)
+    int gridRows;
+    rm_QuadEdges edges;             // Point-in-quad edge data
+    Matrix3x3 inverse;              // Inverse homography (identity in bilinear mode)
+    rm_InvBilinear invBilinear;     // Inverse bilinear coefficients
+} rm_Transform;
+
+// Skyline segment of an atlas page: free space starts at y over [x, x + width)
+typedef struct {
+    int x, y, width;
+} rm_SkylineNode;
+
+// Render texture shared by atlas surfaces, packed bottom-left along a skyline
+typedef struct rm_AtlasPage {
+    RenderTexture2D target;
+    rm_SkylineNode *nodes;
+    int nodeCount;
+    Rectangle freeRects[RM_ATLAS_MAX_FREE]; // Released regions (padding included)
+    int freeCount;
+    int refCount;                   // Regions in use
+    struct rm_AtlasPage *next;
+} rm_AtlasPage;
+
 // Surface structure (internal definition)
 struct RM_Surface {
     int width;                      // Render texture width
     int height;                     // Render texture height
     RM_Quad quad;                   // Corner positions
     RM_MapMode mode;                // Mapping algorithm
-    RenderTexture2D target;         // Render target
+    RenderTexture2D target;         // Render target (the atlas page texture for atlas surfaces)
+    rm_AtlasPage *atlasPage;        // Atlas page holding the target region (NULL if own texture)
+    Rectangle atlasRect;            // Target region in the page, framebuffer coordinates (y up)
     Material material;              // Material with texture
-    Mesh mesh;                      // Deformed mesh
+    Mesh mesh;                      // Deformed mesh (default vertex format)
+    rm_CompactMesh compact;         // Deformed mesh (compact vertex formats)
+    RM_VertexFormat vertexFormat;   // Requested vertex layout
+    RM_VertexFormat meshBuiltFormat; // Layout of the uploaded mesh
+    rm_IndexBuffer *indexBuffer;    // Shared indices of the uploaded mesh
+    bool gpuWarp;                   // Warp in the vertex shader instead of building a mesh
+    rm_ControlGrid grid;            // RM_MAP_GRID control points
+    Vector2 *gridPublished;         // Copy of grid.points published with the transform (max size, never reallocated)
+    bool meshBuiltWarp;             // Uploaded mesh is the shared unit grid
     int meshColumns;                // Mesh horizontal resolution
     int meshRows;                   // Mesh vertical resolution
+    bool meshAuto;                  // Resolution picked from quad distortion (RM_MESH_AUTO)
+    float meshErrorBudget;          // RM_MESH_AUTO pixel error budget
+    int meshBuiltColumns;           // Resolution of the uploaded mesh (0 if none)
+    int meshBuiltRows;
     bool meshNeedsUpdate;           // Dirty flag for mesh
-    Matrix3x3 homography;           // Cached homography matrix
-    bool homographyNeedsUpdate;     // Dirty flag for homography
+    bool editing;                   // Mesh capped to RAYMAP_PROXY_RESOLUTION (interactive edit)
+    bool dynamic;                   // Stream positions through positionRing
+    unsigned int positionRing[RAYMAP_DYNAMIC_SEGMENTS]; // Position VBOs (created on first stream)
+    int ringSegment;                // Segment bound to the VAO
+    RM_BufferStats bufferStats;     // Position upload statistics
+    rm_Transform transform;         // Published mapping transform (see rm_PublishTransform)
+    unsigned int transformSeq;      // Seqlock counter, odd while the transform is being written
+    unsigned int contentGeneration; // Bumped by RM_MarkSurfaceDirty
+    unsigned int renderedGeneration; // Content generation drawn by the last RM_EndSurface
+    unsigned int contentPasses;     // RM_EndSurface calls, never reset (composite caches compare it)
+    Rectangle dirtyRegion;          // Content changed since the last RM_EndSurface, pixel aligned (empty if none)
+    bool scissorPass;               // Current content pass is limited to a region (scissor enabled)
+    RM_ContentStats contentStats;   // Rendered and skipped content passes
+    bool updateQueued;              // Already has a job in the running RM_UpdateSurfaces
+    float blendGamma;               // Edge blending projector gamma (0: not blended)
+    RM_Surface *blendNext;          // Next blended surface (rm_blendSurfaces list)
+    float blendEdges[(1 + RM_MAX_BLEND_NEIGHBORS) * 4][3]; // Inward edge lines: own quad, then overlapping quads
+    int blendNeighborCount;         // Overlapping quads in blendEdges
+    unsigned int blendGeneration;   // rm_blendGeneration blendEdges were found at
 };
 
 //-------------------------------------------------------------------------------------------
@@ -339,9 +976,7 @@ static bool rm_AllocateMeshMemory(Mesh *mesh, int vertexCount, int triangleCount
     mesh->normals = (float *)RMCALLOC(vertexCount * 3, sizeof(float));
     if (!mesh->normals) goto cleanup_failure;
 
-    // Alloc indices
-    mesh->indices = (unsigned short *)RMCALLOC(triangleCount * 3, sizeof(unsigned short));
-    if (!mesh->indices) goto cleanup_failure;
+    // Indices come from the shared index cache (rm_AcquireIndexBuffer)
 
     return true;
 
@@ -351,6 +986,35 @@ cleanup_failure :
     return false;
 }
 
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Arrays
+//--------------------------------------------------------------------------------------------
+
+// Room for one more item in an array that doubles from 16. Returns the array (moved if it
+// grew), or NULL on allocation failure with the old array untouched
+static void *rm_GrowArray(void *items, int count, int *capacity, size_t size)
+{
+    if (count < *capacity) return items;
+    
+    int grown = (*capacity > 0) ? *capacity * 2 : 16;
+    void *moved = RMMALLOC(grown * size);
+    if (!moved) return NULL;
+    if (items) {
+        memcpy(moved, items, count * size);
+        RMFREE(items);
+    }
+    *capacity = grown;
+    return moved;
+}
+
+// Remove item index, keeping the order of the others
+static void rm_RemoveArrayItem(void *items, int *count, int index, size_t size)
+{
+    unsigned char *bytes = (unsigned char *)items;
+    memmove(bytes + index * size, bytes + (index + 1) * size, (*count - index - 1) * size);
+    (*count)--;
+}
+
 //--------------------------------------------------------------------------------------------
 // Internal Helper Functions - Geometry
 //--------------------------------------------------------------------------------------------
@@ -399,6 +1063,16 @@ static void rm_GetDefaultResolutionForMode(RM_MapMode mode, int *cols, int *rows
     }
 }
 
+// Mode name used in logs and config files
+static const char *rm_GetMapModeName(RM_MapMode mode)
+{
+    switch (mode) {
+        case RM_MAP_HOMOGRAPHY: return "HOMOGRAPHY";
+        case RM_MAP_GRID: return "GRID";
+        default: return "BILINEAR";
+    }
+}
+
 // Get default calibration configuration
 static RM_CalibrationConfig rm_GetDefaultCalibrationConfig(void)
 {
@@ -491,161 +1165,142 @@ static Matrix3x3 rm_Matrix3x3Inverse(Matrix3x3 m)
 }
 
 //--------------------------------------------------------------------------------------------
-// Internal Helper Functions - Linear Algebra
+// Internal Helper Functions - Homography
 //--------------------------------------------------------------------------------------------
 
-// Solve 8x8 linear system using Gaussian elimination with partial pivoting
-static int rm_GaussSolve8x8(float A[8][8], float b[8], float x[8])
+// Closed-form unit square -> quad homography (Heckbert, "Fundamentals of Texture Mapping")
+// Source corners are always (0,0) (1,0) (1,1) (0,1), so the 8x8 DLT system reduces to
+// two 2x2 determinants. The affine case (sx = sy = 0) falls out with g = h = 0.
+// Evaluated in double relative to topLeft: the determinants cancel badly in float on
+// strong keystones. Writes row-major h[9], returns false (identity) if quad is degenerate
+static bool rm_SquareToQuad(const RM_Quad *q, float h[9])
 {
-    float A_copy[8][8];
-    float b_copy[8];
-    
-    // Copy input to avoid modifying originals
-    for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            A_copy[i][j] = A[i][j];
-        }
-        b_copy[i] = b[i];
-    }
-    
-    // Forward elimination with partial pivoting
-    for (int k = 0; k < 7; k++) {
-        // Find pivot
-        float max_val = fabsf(A_copy[k][k]);
-        int max_row = k;
-        
-        for (int i = k + 1; i < 8; i++) {
-            if (fabsf(A_copy[i][k]) > max_val) {
-                max_val = fabsf(A_copy[i][k]);
-                max_row = i;
-            }
-        }
-        
-        // Check for singularity
-        if (max_val < RM_EPSILON * 0.01f) {
-            return -1;
-        }
-        
-        // Swap rows if necessary
-        if (max_row != k) {
-            for (int j = 0; j < 8; j++) {
-                float temp = A_copy[k][j];
-                A_copy[k][j] = A_copy[max_row][j];
-                A_copy[max_row][j] = temp;
-            }
-            float temp = b_copy[k];
-            b_copy[k] = b_copy[max_row];
-            b_copy[max_row] = temp;
-        }
-        
-        // Eliminate column
-        for (int i = k + 1; i < 8; i++) {
-            float factor = A_copy[i][k] / A_copy[k][k];
-            for (int j = k; j < 8; j++) {
-                A_copy[i][j] -= factor * A_copy[k][j];
-            }
-            b_copy[i] -= factor * b_copy[k];
-        }
-    }
-    
-    // Check final pivot
-    if (fabsf(A_copy[7][7]) < RM_EPSILON * 0.01f) {
-        return -1;
-    }
-    
-    // Back substitution
-    for (int i = 7; i >= 0; i--) {
-        x[i] = b_copy[i];
-        for (int j = i + 1; j < 8; j++) {
-            x[i] -= A_copy[i][j] * x[j];
-        }
-        x[i] /= A_copy[i][i];
+    double x0 = q->topLeft.x, y0 = q->topLeft.y;
+    double x1 = q->topRight.x - x0,    y1 = q->topRight.y - y0;
+    double x2 = q->bottomRight.x - x0, y2 = q->bottomRight.y - y0;
+    double x3 = q->bottomLeft.x - x0,  y3 = q->bottomLeft.y - y0;
+
+    double sx = (x2 - x1) - x3;
+    double sy = (y2 - y1) - y3;
+    double dx1 = x1 - x2, dx2 = x3 - x2;
+    double dy1 = y1 - y2, dy2 = y3 - y2;
+
+    double den = dx1 * dy2 - dx2 * dy1;
+    if (fabs(den) < RM_EPSILON) {
+        h[0] = 1.0f; h[1] = 0.0f; h[2] = 0.0f;
+        h[3] = 0.0f; h[4] = 1.0f; h[5] = 0.0f;
+        h[6] = 0.0f; h[7] = 0.0f; h[8] = 1.0f;
+        return false;
     }
-    
-    return 0;
+
+    double invDen = 1.0 / den;
+    double g = (sx * dy2 - dx2 * sy) * invDen;
+    double k = (dx1 * sy - sx * dy1) * invDen;
+
+    h[0] = (float)((x1 + g * x1) + g * x0);
+    h[1] = (float)((x3 + k * x3) + k * x0);
+    h[2] = (float)x0;
+    h[3] = (float)((y1 + g * y1) + g * y0);
+    h[4] = (float)((y3 + k * y3) + k * y0);
+    h[5] = (float)y0;
+    h[6] = (float)g;
+    h[7] = (float)k;
+    h[8] = 1.0f;
+
+    return true;
 }
 
-//--------------------------------------------------------------------------------------------
-// Internal Helper Functions - Homography
-//--------------------------------------------------------------------------------------------
+#if defined(RM_SIMD_SSE2)
+// Two lanes of rm_SquareToQuad, same operation order (bit-identical results)
+// c = TLx,TLy,TRx,TRy,BRx,BRy,BLx,BLy, r = h[0..7], returns degenerate lane mask
+static inline __m128d rm_SquareToQuad2(const __m128d c[8], __m128d r[8])
+{
+    __m128d x0 = c[0], y0 = c[1];
+    __m128d x1 = _mm_sub_pd(c[2], x0), y1 = _mm_sub_pd(c[3], y0);
+    __m128d x2 = _mm_sub_pd(c[4], x0), y2 = _mm_sub_pd(c[5], y0);
+    __m128d x3 = _mm_sub_pd(c[6], x0), y3 = _mm_sub_pd(c[7], y0);
+
+    __m128d sx = _mm_sub_pd(_mm_sub_pd(x2, x1), x3);
+    __m128d sy = _mm_sub_pd(_mm_sub_pd(y2, y1), y3);
+    __m128d dx1 = _mm_sub_pd(x1, x2), dx2 = _mm_sub_pd(x3, x2);
+    __m128d dy1 = _mm_sub_pd(y1, y2), dy2 = _mm_sub_pd(y3, y2);
+
+    __m128d one = _mm_set1_pd(1.0);
+    __m128d den = _mm_sub_pd(_mm_mul_pd(dx1, dy2), _mm_mul_pd(dx2, dy1));
+    __m128d bad = _mm_cmplt_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), den), _mm_set1_pd(RM_EPSILON));
+    den = _mm_or_pd(_mm_and_pd(bad, one), _mm_andnot_pd(bad, den));
+
+    __m128d invDen = _mm_div_pd(one, den);
+    __m128d g = _mm_mul_pd(_mm_sub_pd(_mm_mul_pd(sx, dy2), _mm_mul_pd(dx2, sy)), invDen);
+    __m128d k = _mm_mul_pd(_mm_sub_pd(_mm_mul_pd(dx1, sy), _mm_mul_pd(sx, dy1)), invDen);
+
+    r[0] = _mm_add_pd(_mm_add_pd(x1, _mm_mul_pd(g, x1)), _mm_mul_pd(g, x0));
+    r[1] = _mm_add_pd(_mm_add_pd(x3, _mm_mul_pd(k, x3)), _mm_mul_pd(k, x0));
+    r[2] = x0;
+    r[3] = _mm_add_pd(_mm_add_pd(y1, _mm_mul_pd(g, y1)), _mm_mul_pd(g, y0));
+    r[4] = _mm_add_pd(_mm_add_pd(y3, _mm_mul_pd(k, y3)), _mm_mul_pd(k, y0));
+    r[5] = y0;
+    r[6] = g;
+    r[7] = k;
+
+    // Degenerate lanes -> identity
+    for (int i = 0; i < 8; i++) r[i] = _mm_andnot_pd(bad, r[i]);
+    r[0] = _mm_or_pd(r[0], _mm_and_pd(bad, one));
+    r[4] = _mm_or_pd(r[4], _mm_and_pd(bad, one));
+
+    return bad;
+}
 
-// Compute homography matrix from quad using DLT (Direct Linear Transform)
-static Matrix3x3 rm_ComputeHomography(RM_Quad dest)
+// Solve 4 quads at once, returns bitmask of degenerate lanes
+static int rm_SquareToQuad4(const RM_Quad *q, float *out)
 {
-    // Source points (normalized texture coordinates)
-    Vector2 src[4] = {
-        { 0.0f, 0.0f },  // Top-left
-        { 1.0f, 0.0f },  // Top-right
-        { 1.0f, 1.0f },  // Bottom-right
-        { 0.0f, 1.0f }   // Bottom-left
-    };
-    
-    // Destination points (screen coordinates)
-    Vector2 dst[4] = {
-        dest.topLeft,
-        dest.topRight,
-        dest.bottomRight,
-        dest.bottomLeft
-    };
-    
-    // Build 8x9 system of equations (2 equations per correspondence)
-    float A[8][9];
-    
-    for (int i = 0; i < 4; i++) {
-        float x = src[i].x;
-        float y = src[i].y;
-        float u = dst[i].x;
-        float v = dst[i].y;
-        
-        // First equation
-        A[i*2][0] = x;
-        A[i*2][1] = y;
-        A[i*2][2] = 1.0f;
-        A[i*2][3] = 0.0f;
-        A[i*2][4] = 0.0f;
-        A[i*2][5] = 0.0f;
-        A[i*2][6] = -u * x;
-        A[i*2][7] = -u * y;
-        A[i*2][8] = -u;
-        
-        // Second equation
-        A[i*2+1][0] = 0.0f;
-        A[i*2+1][1] = 0.0f;
-        A[i*2+1][2] = 0.0f;
-        A[i*2+1][3] = x;
-        A[i*2+1][4] = y;
-        A[i*2+1][5] = 1.0f;
-        A[i*2+1][6] = -v * x;
-        A[i*2+1][7] = -v * y;
-        A[i*2+1][8] = -v;
-    }
-    
-    // Extract 8x8 coefficient matrix and right-hand side
-    float A_square[8][8];
-    float b[8];
-    
+    const float *p = (const float *)q;
+    __m128 v[8];
+
+    // AoS -> SoA: first half of each quad is TL,TR, second half is BR,BL
+    v[0] = _mm_loadu_ps(p +  0); v[1] = _mm_loadu_ps(p +  8);
+    v[2] = _mm_loadu_ps(p + 16); v[3] = _mm_loadu_ps(p + 24);
+    v[4] = _mm_loadu_ps(p +  4); v[5] = _mm_loadu_ps(p + 12);
+    v[6] = _mm_loadu_ps(p + 20); v[7] = _mm_loadu_ps(p + 28);
+    _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+    _MM_TRANSPOSE4_PS(v[4], v[5], v[6], v[7]);
+
+    __m128d lo[8], hi[8], rlo[8], rhi[8];
     for (int i = 0; i < 8; i++) {
-        for (int j = 0; j < 8; j++) {
-            A_square[i][j] = A[i][j];
-        }
-        b[i] = -A[i][8];
+        lo[i] = _mm_cvtps_pd(v[i]);
+        hi[i] = _mm_cvtps_pd(_mm_movehl_ps(v[i], v[i]));
     }
-    
-    // Solve for homography parameters
+
+    int mask = _mm_movemask_pd(rm_SquareToQuad2(lo, rlo));
+    mask |= _mm_movemask_pd(rm_SquareToQuad2(hi, rhi)) << 2;
+
+    for (int i = 0; i < 8; i++) v[i] = _mm_movelh_ps(_mm_cvtpd_ps(rlo[i]), _mm_cvtpd_ps(rhi[i]));
+
+    // SoA -> AoS (9 floats per quad)
+    _MM_TRANSPOSE4_PS(v[0], v[1], v[2], v[3]);
+    _MM_TRANSPOSE4_PS(v[4], v[5], v[6], v[7]);
+    _mm_storeu_ps(out +  0, v[0]); _mm_storeu_ps(out +  4, v[4]); out[ 8] = 1.0f;
+    _mm_storeu_ps(out +  9, v[1]); _mm_storeu_ps(out + 13, v[5]); out[17] = 1.0f;
+    _mm_storeu_ps(out + 18, v[2]); _mm_storeu_ps(out + 22, v[6]); out[26] = 1.0f;
+    _mm_storeu_ps(out + 27, v[3]); _mm_storeu_ps(out + 31, v[7]); out[35] = 1.0f;
+
+    return mask;
+}
+#endif
+
+// Compute homography matrix mapping the unit square onto the quad
+static Matrix3x3 rm_ComputeHomography(RM_Quad dest)
+{
     float h[9];
-    if (rm_GaussSolve8x8(A_square, b, h) != 0) {
+    if (!rm_SquareToQuad(&dest, h)) {
         TraceLog(LOG_WARNING, "RAYMAP: Homography computation failed, returning identity");
-        return rm_Matrix3x3Identity();
     }
-    
-    h[8] = 1.0f;  // Normalization
-    
-    // Build 3x3 homography matrix
+
     Matrix3x3 H;
     H.m[0][0] = h[0]; H.m[0][1] = h[1]; H.m[0][2] = h[2];
     H.m[1][0] = h[3]; H.m[1][1] = h[4]; H.m[1][2] = h[5];
     H.m[2][0] = h[6]; H.m[2][1] = h[7]; H.m[2][2] = h[8];
-    
+
     return H;
 }
 
@@ -692,409 +1347,5110 @@ static Vector2 rm_BilinearInterpolation(Vector2 p00, Vector2 p10, Vector2 p01, V
 }
 
 //--------------------------------------------------------------------------------------------
-// Internal Helper Functions - Mesh Generation
+// Internal Helper Functions - Inverse Bilinear
 //--------------------------------------------------------------------------------------------
 
-// Generate deformed mesh based on current quad and mapping mode
-static void rm_GenerateBilinearMesh(RM_Surface *surface, int cols, int rows)
+// Per-quad coefficients of P(u,v) = a + u*e + v*f + u*v*g, computed once per quad change
+// (see rm_PublishTransform). Solving for v is then a single quadratic per point:
+//   k2*v^2 + k1*v + k0 = 0 with k2 = cross(g,f), k1 = cross(e,f) + cross(h,g), k0 = cross(h,e)
+static rm_InvBilinear rm_GetInverseBilinear(RM_Quad q)
 {
-    if (!surface) {
-        TraceLog(LOG_ERROR, "RAYMAP: Cannot generate mesh for NULL surface");
-        return;
-    }
-    
-    // Calculate dimensions
-    if (cols > 256 || rows > 256){
-        TraceLog(LOG_ERROR, "RAYMAP: Mesh resolution too hight [%dx%d > 256x256]", cols, rows);
-        return;
-    }
-    
-    size_t vertexCount = (cols + 1) * (rows + 1);
-    size_t triangleCount = cols * rows * 2;
+    rm_InvBilinear result;
+    rm_InvBilinear *ib = &result;
 
-    // Check if index buffer can handle vertex count
-    if (vertexCount > UINT16_MAX){
-        TraceLog(LOG_ERROR, "RAYMAP: Too many vertices (%zu > %d) for index buffer", vertexCount, UINT16_MAX);
-        return;
-    }
+    ib->a = q.topLeft;
+    ib->e = (Vector2){ q.topRight.x - q.topLeft.x, q.topRight.y - q.topLeft.y };
+    ib->f = (Vector2){ q.bottomLeft.x - q.topLeft.x, q.bottomLeft.y - q.topLeft.y };
+    ib->g = (Vector2){ (q.topLeft.x - q.topRight.x) + (q.bottomRight.x - q.bottomLeft.x),
+                       (q.topLeft.y - q.topRight.y) + (q.bottomRight.y - q.bottomLeft.y) };
+
+    float k2 = rm_Cross2D(ib->g, ib->f);
+    ib->kEF = rm_Cross2D(ib->e, ib->f);
+    ib->k2x4 = 4.0f * k2;
+    ib->invK2 = 1.0f / k2;          // inf for trapezoids, only used when the stable root fails
+
+    return result;
+}
+
+// Closed-form inverse bilinear (unclamped). Uses the numerically stable quadratic root
+// v = k0 / q, which also covers the linear case k2 = 0, and falls back to q / k2
+static Vector2 rm_InverseBilinear(const rm_InvBilinear *ib, Vector2 p)
+{
+    Vector2 h = { p.x - ib->a.x, p.y - ib->a.y };
+
+    float k1 = ib->kEF + (h.x * ib->g.y - h.y * ib->g.x);
+    float k0 = h.x * ib->e.y - h.y * ib->e.x;
+    float disc = k1 * k1 - ib->k2x4 * k0;
+    float w = sqrtf((disc > 0.0f) ? disc : 0.0f);
+    float q = -0.5f * (k1 + copysignf(w, k1));
+
+    float v = k0 / q;
+    if (!(v >= -RM_INVBILINEAR_TOLERANCE && v <= 1.0f + RM_INVBILINEAR_TOLERANCE)) v = q * ib->invK2;
+
+    // Divide by the larger component of dP/du for precision on near-vertical edges
+    float dx = ib->e.x + ib->g.x * v;
+    float dy = ib->e.y + ib->g.y * v;
+    float u = (fabsf(dx) >= fabsf(dy)) ? (h.x - ib->f.x * v) / dx : (h.y - ib->f.y * v) / dy;
+
+    return (Vector2){ u, v };
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Batch Point Mapping
+//--------------------------------------------------------------------------------------------
+
+// Clamp to [0,1] with the exact semantics of SSE/AVX min/max (NaN -> 1), so the scalar and
+// vector paths agree bit for bit
+static inline float rm_Clamp01(float x)
+{
+    x = (x < 1.0f) ? x : 1.0f;
+    return (x > 0.0f) ? x : 0.0f;
+}
+
+static rm_QuadEdges rm_GetQuadEdges(RM_Quad quad)
+{
+    rm_QuadEdges e;
+    Vector2 c[4] = { quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft };
+    Vector2 center = {
+        (quad.topLeft.x + quad.topRight.x + quad.bottomLeft.x + quad.bottomRight.x) / 4.0f,
+        (quad.topLeft.y + quad.topRight.y + quad.bottomLeft.y + quad.bottomRight.y) / 4.0f
+    };
+
+    for (int i = 0; i < 4; i++) {
+        Vector2 a = c[i];
+        Vector2 b = c[(i + 1) % 4];
+        Vector2 ab = { b.x - a.x, b.y - a.y };
+        Vector2 ar = { center.x - a.x, center.y - a.y };
+        e.ax[i] = a.x;
+        e.ay[i] = a.y;
+        e.abx[i] = ab.x;
+        e.aby[i] = ab.y;
+        e.refCross[i] = rm_Cross2D(ab, ar);
+    }
+
+    return e;
+}
+
+// Point-in-quad test on precomputed edges (same result as RM_PointInQuad)
+static bool rm_InsideQuadEdges(const rm_QuadEdges *e, Vector2 p)
+{
+    for (int i = 0; i < 4; i++) {
+        Vector2 ab = { e->abx[i], e->aby[i] };
+        Vector2 ap = { p.x - e->ax[i], p.y - e->ay[i] };
+        if (!((rm_Cross2D(ab, ap) * e->refCross[i]) >= 0.0f)) return false;
+    }
+    return true;
+}
+
+// Unmap one point with a precomputed inverse homography (shared by scalar API and batch tails)
+static Vector2 rm_UnmapPointInverse(const rm_QuadEdges *e, Matrix3x3 invH, Vector2 p)
+{
+    if (!rm_InsideQuadEdges(e, p)) {
+        return (Vector2){ -1.0f, -1.0f };
+    }
+
+    Vector2 uv = rm_ApplyHomography(invH, p.x, p.y);
+    uv.x = rm_Clamp01(uv.x);
+    uv.y = rm_Clamp01(uv.y);
+
+    return uv;
+}
+
+// Unmap one point in bilinear mode with the cached inverse bilinear coefficients
+static Vector2 rm_UnmapPointBilinear(const rm_QuadEdges *e, const rm_InvBilinear *ib, Vector2 p)
+{
+    if (!rm_InsideQuadEdges(e, p)) {
+        return (Vector2){ -1.0f, -1.0f };
+    }
+
+    Vector2 uv = rm_InverseBilinear(ib, p);
+    uv.x = rm_Clamp01(uv.x);
+    uv.y = rm_Clamp01(uv.y);
+
+    return uv;
+}
+
+#if defined(RM_SIMD_SSE2)
+// 4 points: interleaved xy -> SoA
+static inline void rm_Load4(const Vector2 *p, __m128 *x, __m128 *y)
+{
+    __m128 a = _mm_loadu_ps(&p[0].x);
+    __m128 b = _mm_loadu_ps(&p[2].x);
+    *x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    *y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void rm_Store4(Vector2 *p, __m128 x, __m128 y)
+{
+    _mm_storeu_ps(&p[0].x, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(&p[2].x, _mm_unpackhi_ps(x, y));
+}
+
+static inline __m128 rm_Clamp01x4(__m128 x)
+{
+    return _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(1.0f)), _mm_setzero_ps());
+}
+
+// rm_ApplyHomography on 4 points
+static inline void rm_ApplyHomography4(const Matrix3x3 *H, __m128 u, __m128 v, __m128 *ox, __m128 *oy)
+{
+    __m128 x = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(H->m[0][0]), u), _mm_mul_ps(_mm_set1_ps(H->m[0][1]), v)), _mm_set1_ps(H->m[0][2]));
+    __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(H->m[1][0]), u), _mm_mul_ps(_mm_set1_ps(H->m[1][1]), v)), _mm_set1_ps(H->m[1][2]));
+    __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(H->m[2][0]), u), _mm_mul_ps(_mm_set1_ps(H->m[2][1]), v)), _mm_set1_ps(H->m[2][2]));
+
+    __m128 divide = _mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), w), _mm_set1_ps(RM_EPSILON));
+    *ox = _mm_or_ps(_mm_and_ps(divide, _mm_div_ps(x, w)), _mm_andnot_ps(divide, x));
+    *oy = _mm_or_ps(_mm_and_ps(divide, _mm_div_ps(y, w)), _mm_andnot_ps(divide, y));
+}
+
+// rm_BilinearInterpolation on 4 points
+static inline void rm_Bilinear4(const RM_Quad *q, __m128 u, __m128 v, __m128 *ox, __m128 *oy)
+{
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 iu = _mm_sub_ps(one, u), iv = _mm_sub_ps(one, v);
+    __m128 w00 = _mm_mul_ps(iu, iv), w10 = _mm_mul_ps(u, iv);
+    __m128 w01 = _mm_mul_ps(iu, v), w11 = _mm_mul_ps(u, v);
+
+    *ox = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w00, _mm_set1_ps(q->topLeft.x)), _mm_mul_ps(w10, _mm_set1_ps(q->topRight.x))),
+                                _mm_mul_ps(w01, _mm_set1_ps(q->bottomLeft.x))), _mm_mul_ps(w11, _mm_set1_ps(q->bottomRight.x)));
+    *oy = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w00, _mm_set1_ps(q->topLeft.y)), _mm_mul_ps(w10, _mm_set1_ps(q->topRight.y))),
+                                _mm_mul_ps(w01, _mm_set1_ps(q->bottomLeft.y))), _mm_mul_ps(w11, _mm_set1_ps(q->bottomRight.y)));
+}
+
+// Point-in-quad mask on 4 points
+static inline __m128 rm_InsideQuad4(const rm_QuadEdges *e, __m128 px, __m128 py)
+{
+    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int i = 0; i < 4; i++) {
+        __m128 apx = _mm_sub_ps(px, _mm_set1_ps(e->ax[i]));
+        __m128 apy = _mm_sub_ps(py, _mm_set1_ps(e->ay[i]));
+        __m128 cross = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(e->abx[i]), apy), _mm_mul_ps(_mm_set1_ps(e->aby[i]), apx));
+        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_mul_ps(cross, _mm_set1_ps(e->refCross[i])), _mm_setzero_ps()));
+    }
+    return inside;
+}
+#endif
+
+#if defined(RM_SIMD_AVX)
+// 8 points: interleaved xy -> SoA (lane order is irrelevant, rm_Store8 undoes it)
+static inline void rm_Load8(const Vector2 *p, __m256 *x, __m256 *y)
+{
+    __m256 a = _mm256_loadu_ps(&p[0].x);
+    __m256 b = _mm256_loadu_ps(&p[4].x);
+    *x = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    *y = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void rm_Store8(Vector2 *p, __m256 x, __m256 y)
+{
+    _mm256_storeu_ps(&p[0].x, _mm256_unpacklo_ps(x, y));
+    _mm256_storeu_ps(&p[4].x, _mm256_unpackhi_ps(x, y));
+}
+
+static inline __m256 rm_Clamp01x8(__m256 x)
+{
+    return _mm256_max_ps(_mm256_min_ps(x, _mm256_set1_ps(1.0f)), _mm256_setzero_ps());
+}
+
+static inline void rm_ApplyHomography8(const Matrix3x3 *H, __m256 u, __m256 v, __m256 *ox, __m256 *oy)
+{
+    __m256 x = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(H->m[0][0]), u), _mm256_mul_ps(_mm256_set1_ps(H->m[0][1]), v)), _mm256_set1_ps(H->m[0][2]));
+    __m256 y = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(H->m[1][0]), u), _mm256_mul_ps(_mm256_set1_ps(H->m[1][1]), v)), _mm256_set1_ps(H->m[1][2]));
+    __m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(H->m[2][0]), u), _mm256_mul_ps(_mm256_set1_ps(H->m[2][1]), v)), _mm256_set1_ps(H->m[2][2]));
+
+    __m256 divide = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), w), _mm256_set1_ps(RM_EPSILON), _CMP_GT_OQ);
+    *ox = _mm256_blendv_ps(x, _mm256_div_ps(x, w), divide);
+    *oy = _mm256_blendv_ps(y, _mm256_div_ps(y, w), divide);
+}
+
+static inline void rm_Bilinear8(const RM_Quad *q, __m256 u, __m256 v, __m256 *ox, __m256 *oy)
+{
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 iu = _mm256_sub_ps(one, u), iv = _mm256_sub_ps(one, v);
+    __m256 w00 = _mm256_mul_ps(iu, iv), w10 = _mm256_mul_ps(u, iv);
+    __m256 w01 = _mm256_mul_ps(iu, v), w11 = _mm256_mul_ps(u, v);
+
+    *ox = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(w00, _mm256_set1_ps(q->topLeft.x)), _mm256_mul_ps(w10, _mm256_set1_ps(q->topRight.x))),
+                                      _mm256_mul_ps(w01, _mm256_set1_ps(q->bottomLeft.x))), _mm256_mul_ps(w11, _mm256_set1_ps(q->bottomRight.x)));
+    *oy = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(w00, _mm256_set1_ps(q->topLeft.y)), _mm256_mul_ps(w10, _mm256_set1_ps(q->topRight.y))),
+                                      _mm256_mul_ps(w01, _mm256_set1_ps(q->bottomLeft.y))), _mm256_mul_ps(w11, _mm256_set1_ps(q->bottomRight.y)));
+}
+
+static inline __m256 rm_InsideQuad8(const rm_QuadEdges *e, __m256 px, __m256 py)
+{
+    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    for (int i = 0; i < 4; i++) {
+        __m256 apx = _mm256_sub_ps(px, _mm256_set1_ps(e->ax[i]));
+        __m256 apy = _mm256_sub_ps(py, _mm256_set1_ps(e->ay[i]));
+        __m256 cross = _mm256_sub_ps(_mm256_mul_ps(_mm256_set1_ps(e->abx[i]), apy), _mm256_mul_ps(_mm256_set1_ps(e->aby[i]), apx));
+        inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_mul_ps(cross, _mm256_set1_ps(e->refCross[i])), _mm256_setzero_ps(), _CMP_GE_OQ));
+    }
+    return inside;
+}
+#endif
+
+// Map texture points to screen, homography mode (input clamped to [0,1])
+static void rm_MapPointsHomography(Matrix3x3 H, const Vector2 *in, Vector2 *out, int count)
+{
+    int i = 0;
+#if defined(RM_SIMD_AVX)
+    for (; i + 8 <= count; i += 8) {
+        __m256 u, v, x, y;
+        rm_Load8(&in[i], &u, &v);
+        rm_ApplyHomography8(&H, rm_Clamp01x8(u), rm_Clamp01x8(v), &x, &y);
+        rm_Store8(&out[i], x, y);
+    }
+#endif
+#if defined(RM_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 u, v, x, y;
+        rm_Load4(&in[i], &u, &v);
+        rm_ApplyHomography4(&H, rm_Clamp01x4(u), rm_Clamp01x4(v), &x, &y);
+        rm_Store4(&out[i], x, y);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = rm_ApplyHomography(H, rm_Clamp01(in[i].x), rm_Clamp01(in[i].y));
+    }
+}
+
+// Map texture points to screen, bilinear mode (input clamped to [0,1])
+static void rm_MapPointsBilinear(RM_Quad q, const Vector2 *in, Vector2 *out, int count)
+{
+    int i = 0;
+#if defined(RM_SIMD_AVX)
+    for (; i + 8 <= count; i += 8) {
+        __m256 u, v, x, y;
+        rm_Load8(&in[i], &u, &v);
+        rm_Bilinear8(&q, rm_Clamp01x8(u), rm_Clamp01x8(v), &x, &y);
+        rm_Store8(&out[i], x, y);
+    }
+#endif
+#if defined(RM_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 u, v, x, y;
+        rm_Load4(&in[i], &u, &v);
+        rm_Bilinear4(&q, rm_Clamp01x4(u), rm_Clamp01x4(v), &x, &y);
+        rm_Store4(&out[i], x, y);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = rm_BilinearInterpolation(q.topLeft, q.topRight, q.bottomLeft, q.bottomRight,
+                                          rm_Clamp01(in[i].x), rm_Clamp01(in[i].y));
+    }
+}
+
+// Unmap screen points with a precomputed inverse homography ((-1,-1) outside the quad)
+static void rm_UnmapPointsInverse(const rm_QuadEdges *e, Matrix3x3 invH, const Vector2 *in, Vector2 *out, int count)
+{
+    int i = 0;
+#if defined(RM_SIMD_AVX)
+    for (; i + 8 <= count; i += 8) {
+        __m256 px, py, u, v;
+        rm_Load8(&in[i], &px, &py);
+        __m256 inside = rm_InsideQuad8(e, px, py);
+        rm_ApplyHomography8(&invH, px, py, &u, &v);
+        __m256 outside = _mm256_set1_ps(-1.0f);
+        u = _mm256_blendv_ps(outside, rm_Clamp01x8(u), inside);
+        v = _mm256_blendv_ps(outside, rm_Clamp01x8(v), inside);
+        rm_Store8(&out[i], u, v);
+    }
+#endif
+#if defined(RM_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 px, py, u, v;
+        rm_Load4(&in[i], &px, &py);
+        __m128 inside = rm_InsideQuad4(e, px, py);
+        rm_ApplyHomography4(&invH, px, py, &u, &v);
+        __m128 outside = _mm_andnot_ps(inside, _mm_set1_ps(-1.0f));
+        u = _mm_or_ps(_mm_and_ps(inside, rm_Clamp01x4(u)), outside);
+        v = _mm_or_ps(_mm_and_ps(inside, rm_Clamp01x4(v)), outside);
+        rm_Store4(&out[i], u, v);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = rm_UnmapPointInverse(e, invH, in[i]);
+    }
+}
+
+#if defined(RM_SIMD_SSE2)
+// rm_InverseBilinear on 4 points
+static inline void rm_InverseBilinear4(const rm_InvBilinear *ib, __m128 px, __m128 py, __m128 *ou, __m128 *ov)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    __m128 ex = _mm_set1_ps(ib->e.x), ey = _mm_set1_ps(ib->e.y);
+    __m128 fx = _mm_set1_ps(ib->f.x), fy = _mm_set1_ps(ib->f.y);
+    __m128 gx = _mm_set1_ps(ib->g.x), gy = _mm_set1_ps(ib->g.y);
+
+    __m128 hx = _mm_sub_ps(px, _mm_set1_ps(ib->a.x));
+    __m128 hy = _mm_sub_ps(py, _mm_set1_ps(ib->a.y));
+
+    __m128 k1 = _mm_add_ps(_mm_set1_ps(ib->kEF), _mm_sub_ps(_mm_mul_ps(hx, gy), _mm_mul_ps(hy, gx)));
+    __m128 k0 = _mm_sub_ps(_mm_mul_ps(hx, ey), _mm_mul_ps(hy, ex));
+    __m128 disc = _mm_sub_ps(_mm_mul_ps(k1, k1), _mm_mul_ps(_mm_set1_ps(ib->k2x4), k0));
+    __m128 w = _mm_sqrt_ps(_mm_max_ps(disc, _mm_setzero_ps()));
+    w = _mm_or_ps(_mm_andnot_ps(sign, w), _mm_and_ps(sign, k1));
+    __m128 q = _mm_mul_ps(_mm_set1_ps(-0.5f), _mm_add_ps(k1, w));
+
+    __m128 v = _mm_div_ps(k0, q);
+    __m128 valid = _mm_and_ps(_mm_cmpge_ps(v, _mm_set1_ps(-RM_INVBILINEAR_TOLERANCE)),
+                              _mm_cmple_ps(v, _mm_set1_ps(1.0f + RM_INVBILINEAR_TOLERANCE)));
+    v = _mm_or_ps(_mm_and_ps(valid, v), _mm_andnot_ps(valid, _mm_mul_ps(q, _mm_set1_ps(ib->invK2))));
+
+    __m128 dx = _mm_add_ps(ex, _mm_mul_ps(gx, v));
+    __m128 dy = _mm_add_ps(ey, _mm_mul_ps(gy, v));
+    __m128 useX = _mm_cmpge_ps(_mm_andnot_ps(sign, dx), _mm_andnot_ps(sign, dy));
+    __m128 ux = _mm_div_ps(_mm_sub_ps(hx, _mm_mul_ps(fx, v)), dx);
+    __m128 uy = _mm_div_ps(_mm_sub_ps(hy, _mm_mul_ps(fy, v)), dy);
+
+    *ou = _mm_or_ps(_mm_and_ps(useX, ux), _mm_andnot_ps(useX, uy));
+    *ov = v;
+}
+#endif
+
+#if defined(RM_SIMD_AVX)
+// rm_InverseBilinear on 8 points
+static inline void rm_InverseBilinear8(const rm_InvBilinear *ib, __m256 px, __m256 py, __m256 *ou, __m256 *ov)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    __m256 ex = _mm256_set1_ps(ib->e.x), ey = _mm256_set1_ps(ib->e.y);
+    __m256 fx = _mm256_set1_ps(ib->f.x), fy = _mm256_set1_ps(ib->f.y);
+    __m256 gx = _mm256_set1_ps(ib->g.x), gy = _mm256_set1_ps(ib->g.y);
+
+    __m256 hx = _mm256_sub_ps(px, _mm256_set1_ps(ib->a.x));
+    __m256 hy = _mm256_sub_ps(py, _mm256_set1_ps(ib->a.y));
+
+    __m256 k1 = _mm256_add_ps(_mm256_set1_ps(ib->kEF), _mm256_sub_ps(_mm256_mul_ps(hx, gy), _mm256_mul_ps(hy, gx)));
+    __m256 k0 = _mm256_sub_ps(_mm256_mul_ps(hx, ey), _mm256_mul_ps(hy, ex));
+    __m256 disc = _mm256_sub_ps(_mm256_mul_ps(k1, k1), _mm256_mul_ps(_mm256_set1_ps(ib->k2x4), k0));
+    __m256 w = _mm256_sqrt_ps(_mm256_max_ps(disc, _mm256_setzero_ps()));
+    w = _mm256_or_ps(_mm256_andnot_ps(sign, w), _mm256_and_ps(sign, k1));
+    __m256 q = _mm256_mul_ps(_mm256_set1_ps(-0.5f), _mm256_add_ps(k1, w));
+
+    __m256 v = _mm256_div_ps(k0, q);
+    __m256 valid = _mm256_and_ps(_mm256_cmp_ps(v, _mm256_set1_ps(-RM_INVBILINEAR_TOLERANCE), _CMP_GE_OQ),
+                                 _mm256_cmp_ps(v, _mm256_set1_ps(1.0f + RM_INVBILINEAR_TOLERANCE), _CMP_LE_OQ));
+    v = _mm256_blendv_ps(_mm256_mul_ps(q, _mm256_set1_ps(ib->invK2)), v, valid);
+
+    __m256 dx = _mm256_add_ps(ex, _mm256_mul_ps(gx, v));
+    __m256 dy = _mm256_add_ps(ey, _mm256_mul_ps(gy, v));
+    __m256 useX = _mm256_cmp_ps(_mm256_andnot_ps(sign, dx), _mm256_andnot_ps(sign, dy), _CMP_GE_OQ);
+    __m256 ux = _mm256_div_ps(_mm256_sub_ps(hx, _mm256_mul_ps(fx, v)), dx);
+    __m256 uy = _mm256_div_ps(_mm256_sub_ps(hy, _mm256_mul_ps(fy, v)), dy);
+
+    *ou = _mm256_blendv_ps(uy, ux, useX);
+    *ov = v;
+}
+#endif
+
+// Unmap screen points in bilinear mode ((-1,-1) outside the quad)
+static void rm_UnmapPointsBilinear(const rm_QuadEdges *e, const rm_InvBilinear *ib, const Vector2 *in, Vector2 *out, int count)
+{
+    int i = 0;
+#if defined(RM_SIMD_AVX)
+    for (; i + 8 <= count; i += 8) {
+        __m256 px, py, u, v;
+        rm_Load8(&in[i], &px, &py);
+        __m256 inside = rm_InsideQuad8(e, px, py);
+        rm_InverseBilinear8(ib, px, py, &u, &v);
+        __m256 outside = _mm256_set1_ps(-1.0f);
+        u = _mm256_blendv_ps(outside, rm_Clamp01x8(u), inside);
+        v = _mm256_blendv_ps(outside, rm_Clamp01x8(v), inside);
+        rm_Store8(&out[i], u, v);
+    }
+#endif
+#if defined(RM_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 px, py, u, v;
+        rm_Load4(&in[i], &px, &py);
+        __m128 inside = rm_InsideQuad4(e, px, py);
+        rm_InverseBilinear4(ib, px, py, &u, &v);
+        __m128 outside = _mm_andnot_ps(inside, _mm_set1_ps(-1.0f));
+        u = _mm_or_ps(_mm_and_ps(inside, rm_Clamp01x4(u)), outside);
+        v = _mm_or_ps(_mm_and_ps(inside, rm_Clamp01x4(v)), outside);
+        rm_Store4(&out[i], u, v);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = rm_UnmapPointBilinear(e, ib, in[i]);
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Transform Snapshot
+//--------------------------------------------------------------------------------------------
+
+// Byte ranges of rm_Transform needed by each direction, readers only copy their half
+#define RM_TRANSFORM_FORWARD_BEGIN  offsetof(rm_Transform, quad)
+#define RM_TRANSFORM_FORWARD_END    offsetof(rm_Transform, edges)
+#define RM_TRANSFORM_INVERSE_BEGIN  offsetof(rm_Transform, mode)
+#define RM_TRANSFORM_INVERSE_END    sizeof(rm_Transform)
+
+// Bumped when the set or the quads of blended surfaces change (see Edge Blending)
+static unsigned int rm_blendGeneration = 1;
+
+// Rebuild the transform from surface->quad and surface->mode and publish it, together with the
+// control lattice (writer side). Must be called from a single thread, the one that owns
+// RM_SetQuad/RM_SetMapMode and the grid functions
+static void rm_PublishTransform(RM_Surface *surface)
+{
+    // Overlaps with other blended surfaces are found again on their next draw
+    if (surface->blendGamma > 0.0f) rm_blendGeneration++;
     
-    TraceLog(LOG_DEBUG, "RAYMAP: Generating mesh [%dx%d = %d vertices, %d triangles]",
-             cols, rows, vertexCount, triangleCount);
+    rm_Transform t;
+    t.quad = surface->quad;
+    t.mode = surface->mode;
+    t.edges = rm_GetQuadEdges(surface->quad);
+    t.invBilinear = rm_GetInverseBilinear(surface->quad);
+
+    // Forward and inverse homography are only built in the mode that uses them
+    if (surface->mode == RM_MAP_HOMOGRAPHY) {
+        t.homography = rm_ComputeHomography(surface->quad);
+        t.inverse = rm_Matrix3x3Inverse(t.homography);
+    } else {
+        t.homography = rm_Matrix3x3Identity();
+        t.inverse = rm_Matrix3x3Identity();
+    }
     
-    // Allocate new mesh
-    Mesh newMesh = { 0 };
-    if (!rm_AllocateMeshMemory(&newMesh, (int)vertexCount, (int)triangleCount)){
-        return; // Error already logged
+    // The lattice is copied too in grid mode: grid.points is edited and reallocated in place
+    bool grid = (surface->mode == RM_MAP_GRID && surface->grid.points && surface->gridPublished);
+    t.gridColumns = grid ? surface->grid.columns : 0;
+    t.gridRows = grid ? surface->grid.rows : 0;
+
+    // Odd sequence while writing, readers that overlap the copy retry
+    unsigned int seq = surface->transformSeq;
+    RM_SEQ_STORE(&surface->transformSeq, seq + 1);
+    RM_SEQ_FENCE_RELEASE();
+    surface->transform = t;
+    if (grid) memcpy(surface->gridPublished, surface->grid.points, t.gridColumns * t.gridRows * sizeof(Vector2));
+    RM_SEQ_FENCE_RELEASE();
+    RM_SEQ_STORE(&surface->transformSeq, seq + 2);
+}
+
+// Copy bytes [begin, end) of the published transform into the same range of *out, and the
+// published lattice into gridPoints if not NULL (reader side, [begin, end) must hold the grid
+// size then). Lock-free: spins only while a writer is inside rm_PublishTransform
+static inline void rm_ReadTransformGrid(const RM_Surface *surface, rm_Transform *out, size_t begin, size_t end, Vector2 *gridPoints)
+{
+    const unsigned char *src = (const unsigned char *)&surface->transform + begin;
+    unsigned char *dst = (unsigned char *)out + begin;
+
+    for (;;) {
+        unsigned int seq = RM_SEQ_LOAD(&surface->transformSeq);
+        if (seq & 1u) {
+            RM_SEQ_PAUSE();
+            continue;
+        }
+        RM_SEQ_FENCE_ACQUIRE();
+        memcpy(dst, src, end - begin);
+        
+        // The size may be torn too: only copy what fits, the sequence check rejects it anyway
+        if (gridPoints) {
+            int count = out->gridColumns * out->gridRows;
+            if (count > 0 && count <= RM_MAX_GRID_POINTS * RM_MAX_GRID_POINTS) {
+                memcpy(gridPoints, surface->gridPublished, count * sizeof(Vector2));
+            }
+        }
+        RM_SEQ_FENCE_ACQUIRE();
+        if (RM_SEQ_LOAD(&surface->transformSeq) == seq) return;
     }
+}
 
-    // Compute homography if needed
-    RM_Quad q = surface->quad;
-    if (surface->mode == RM_MAP_HOMOGRAPHY && surface->homographyNeedsUpdate) {
-        surface->homography = rm_ComputeHomography(surface->quad);
-        surface->homographyNeedsUpdate = false;
-        TraceLog(LOG_DEBUG, "RAYMAP: Homography computed");
+static inline void rm_ReadTransform(const RM_Surface *surface, rm_Transform *out, size_t begin, size_t end)
+{
+    rm_ReadTransformGrid(surface, out, begin, end, NULL);
+}
+
+// Control lattice over the points copied by rm_ReadTransformGrid (RM_MAP_GRID transforms)
+static inline rm_ControlGrid rm_GetGridSnapshot(const rm_Transform *t, Vector2 *points)
+{
+    rm_ControlGrid g = { 0 };
+    g.points = points;
+    g.columns = t->gridColumns;
+    g.rows = t->gridRows;
+    return g;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Control Grid
+//--------------------------------------------------------------------------------------------
+
+// Spline span of parameter t in [0,1] over n control points (value or d/dt weights)
+static rm_SplineSpan rm_GetSplineSpan(float t, int n, bool derivative)
+{
+    float s = t * (float)(n - 1);
+    int span = (int)s;
+    if (span > n - 2) span = n - 2;
+    if (span < 0) span = 0;
+    float f = s - (float)span;
+    float f2 = f * f;
+    float f3 = f2 * f;
+    
+    rm_SplineSpan r;
+    if (derivative) {
+        float k = 0.5f * (float)(n - 1);
+        r.w[0] = k * (-3.0f * f2 + 4.0f * f - 1.0f);
+        r.w[1] = k * (9.0f * f2 - 10.0f * f);
+        r.w[2] = k * (-9.0f * f2 + 8.0f * f + 1.0f);
+        r.w[3] = k * (3.0f * f2 - 2.0f * f);
+    } else {
+        r.w[0] = 0.5f * (-f3 + 2.0f * f2 - f);
+        r.w[1] = 0.5f * (3.0f * f3 - 5.0f * f2 + 2.0f);
+        r.w[2] = 0.5f * (-3.0f * f3 + 4.0f * f2 + f);
+        r.w[3] = 0.5f * (f3 - f2);
     }
+    r.index[0] = span - 1;
+    r.index[1] = span;
+    r.index[2] = span + 1;
+    r.index[3] = span + 2;
     
-    // Generate vertices
-    int vIdx = 0;
-    for (int y = 0; y <= rows; y++) {
-        for (int x = 0; x <= cols; x++) {
-            float u = (float)x / (float)cols;
-            float v = (float)y / (float)rows;
-            
-            Vector2 pos;
-            if (surface->mode == RM_MAP_HOMOGRAPHY) {
-                pos = rm_ApplyHomography(surface->homography, u, v);
-            } else {
-                pos = rm_BilinearInterpolation(
-                    q.topLeft, q.topRight,
-                    q.bottomLeft, q.bottomRight,
-                    u, v
-                );
+    // Phantom points: P[-1] = 2 P[0] - P[1] and P[n] = 2 P[n-1] - P[n-2]
+    if (span == 0) {
+        r.w[1] += 2.0f * r.w[0];
+        r.w[2] -= r.w[0];
+        r.w[0] = 0.0f;
+        r.index[0] = 0;
+    }
+    if (span == n - 2) {
+        r.w[2] += 2.0f * r.w[3];
+        r.w[1] -= r.w[3];
+        r.w[3] = 0.0f;
+        r.index[3] = n - 1;
+    }
+    return r;
+}
+
+// Control point with phantom points past the ends (one axis out of range at most)
+static Vector2 rm_GetGridNode(const rm_ControlGrid *g, int i, int j)
+{
+    if (i < 0) return Vector2Subtract(Vector2Scale(rm_GetGridNode(g, 0, j), 2.0f), rm_GetGridNode(g, 1, j));
+    if (i >= g->columns) return Vector2Subtract(Vector2Scale(rm_GetGridNode(g, g->columns - 1, j), 2.0f), rm_GetGridNode(g, g->columns - 2, j));
+    if (j < 0) return Vector2Subtract(Vector2Scale(rm_GetGridNode(g, i, 0), 2.0f), rm_GetGridNode(g, i, 1));
+    if (j >= g->rows) return Vector2Subtract(Vector2Scale(rm_GetGridNode(g, i, g->rows - 1), 2.0f), rm_GetGridNode(g, i, g->rows - 2));
+    return g->points[j * g->columns + i];
+}
+
+// Largest second derivative of the Catmull-Rom segment P1 -> P2. It is linear in t, so the
+// extremes are at the ends: 2 P0 - 5 P1 + 4 P2 - P3 and -P0 + 4 P1 - 5 P2 + 2 P3
+static float rm_SplineCurvature(Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3)
+{
+    float ax = 2.0f * p0.x - 5.0f * p1.x + 4.0f * p2.x - p3.x;
+    float ay = 2.0f * p0.y - 5.0f * p1.y + 4.0f * p2.y - p3.y;
+    float bx = -p0.x + 4.0f * p1.x - 5.0f * p2.x + 2.0f * p3.x;
+    float by = -p0.y + 4.0f * p1.y - 5.0f * p2.y + 2.0f * p3.y;
+    return fmaxf(sqrtf(ax * ax + ay * ay), sqrtf(bx * bx + by * by));
+}
+
+// Bezier control point k of row j along u (3 per span, segment P1 -> P2 becomes P1,
+// P1 + (P2 - P0) / 6, P2 - (P3 - P1) / 6, P2). Rows -1 and rows are the phantom rows
+static Vector2 rm_GetGridBezierU(const rm_ControlGrid *g, int k, int j)
+{
+    if (j < 0) return Vector2Subtract(Vector2Scale(rm_GetGridBezierU(g, k, 0), 2.0f), rm_GetGridBezierU(g, k, 1));
+    if (j >= g->rows) return Vector2Subtract(Vector2Scale(rm_GetGridBezierU(g, k, g->rows - 1), 2.0f), rm_GetGridBezierU(g, k, g->rows - 2));
+    
+    int i = k / 3;
+    if (k % 3 == 0) return rm_GetGridNode(g, i, j);
+    Vector2 p0 = rm_GetGridNode(g, i - 1, j);
+    Vector2 p1 = rm_GetGridNode(g, i, j);
+    Vector2 p2 = rm_GetGridNode(g, i + 1, j);
+    Vector2 p3 = rm_GetGridNode(g, i + 2, j);
+    if (k % 3 == 1) return Vector2Add(p1, Vector2Scale(Vector2Subtract(p2, p0), 1.0f / 6.0f));
+    return Vector2Subtract(p2, Vector2Scale(Vector2Subtract(p3, p1), 1.0f / 6.0f));
+}
+
+// Bounds of the spline surface. Spans can bulge past the control points, but each patch lies
+// in the convex hull of its bicubic Bezier net, so the box of the net contains it
+static Rectangle rm_GetGridBounds(const rm_ControlGrid *g)
+{
+    Vector2 lo = g->points[0], hi = g->points[0];
+    for (int k = 0; k <= 3 * (g->columns - 1); k++) {
+        for (int j = 0; j < g->rows; j++) {
+            Vector2 q[3] = { rm_GetGridBezierU(g, k, j), { 0.0f, 0.0f }, { 0.0f, 0.0f } };
+            int n = 1;
+            if (j < g->rows - 1) {
+                Vector2 q0 = rm_GetGridBezierU(g, k, j - 1);
+                Vector2 q2 = rm_GetGridBezierU(g, k, j + 1);
+                Vector2 q3 = rm_GetGridBezierU(g, k, j + 2);
+                q[1] = Vector2Add(q[0], Vector2Scale(Vector2Subtract(q2, q0), 1.0f / 6.0f));
+                q[2] = Vector2Subtract(q2, Vector2Scale(Vector2Subtract(q3, q[0]), 1.0f / 6.0f));
+                n = 3;
             }
-            
-            // Vertex position
-            newMesh.vertices[vIdx * 3 + 0] = pos.x;
-            newMesh.vertices[vIdx * 3 + 1] = pos.y;
-            newMesh.vertices[vIdx * 3 + 2] = 0.0f;
-            
-            // Texture coordinates
-            newMesh.texcoords[vIdx * 2 + 0] = u;
-            newMesh.texcoords[vIdx * 2 + 1] = 1.0f - v;  // Flip V for raylib
-            
-            // Normals (all pointing towards +Z)
-            newMesh.normals[vIdx * 3 + 0] = 0.0f;
-            newMesh.normals[vIdx * 3 + 1] = 0.0f;
-            newMesh.normals[vIdx * 3 + 2] = 1.0f;
-            
-            vIdx++;
+            for (int m = 0; m < n; m++) {
+                lo.x = fminf(lo.x, q[m].x);
+                lo.y = fminf(lo.y, q[m].y);
+                hi.x = fmaxf(hi.x, q[m].x);
+                hi.y = fmaxf(hi.y, q[m].y);
+            }
+        }
+    }
+    return (Rectangle){ lo.x, lo.y, hi.x - lo.x, hi.y - lo.y };
+}
+
+// Refresh curvature and bounds after control points moved
+static void rm_UpdateGridMetrics(rm_ControlGrid *g)
+{
+    float cu = 0.0f, cv = 0.0f;
+    for (int j = 0; j < g->rows; j++) {
+        for (int i = 0; i < g->columns - 1; i++) {
+            cu = fmaxf(cu, rm_SplineCurvature(rm_GetGridNode(g, i - 1, j), rm_GetGridNode(g, i, j),
+                                              rm_GetGridNode(g, i + 1, j), rm_GetGridNode(g, i + 2, j)));
+        }
+    }
+    for (int i = 0; i < g->columns; i++) {
+        for (int j = 0; j < g->rows - 1; j++) {
+            cv = fmaxf(cv, rm_SplineCurvature(rm_GetGridNode(g, i, j - 1), rm_GetGridNode(g, i, j),
+                                              rm_GetGridNode(g, i, j + 1), rm_GetGridNode(g, i, j + 2)));
         }
     }
+    g->curvatureU = cu;
+    g->curvatureV = cv;
+    g->bounds = rm_GetGridBounds(g);
+}
+
+static void rm_ClearGridDirty(rm_ControlGrid *g)
+{
+    g->dirtyMinX = g->dirtyMinY = RM_MAX_GRID_POINTS;
+    g->dirtyMaxX = g->dirtyMaxY = -1;
+}
+
+// Position (and optionally partial derivatives) of the grid surface at (u, v)
+static Vector2 rm_EvaluateGrid(const rm_ControlGrid *g, float u, float v, Vector2 *dPdu, Vector2 *dPdv)
+{
+    rm_SplineSpan su = rm_GetSplineSpan(u, g->columns, false);
+    rm_SplineSpan sv = rm_GetSplineSpan(v, g->rows, false);
+    rm_SplineSpan du = { 0 }, dv = { 0 };
+    bool derivatives = (dPdu && dPdv);
+    if (derivatives) {
+        du = rm_GetSplineSpan(u, g->columns, true);
+        dv = rm_GetSplineSpan(v, g->rows, true);
+    }
     
-    // Generate indices
-    int iIdx = 0;
-    for (int y = 0; y < rows; y++) {
-        for (int x = 0; x < cols; x++) {
-            int topLeft = y * (cols + 1) + x;
-            int topRight = topLeft + 1;
-            int bottomLeft = (y + 1) * (cols + 1) + x;
-            int bottomRight = bottomLeft + 1;
-            
-            // First triangle
-            newMesh.indices[iIdx++] = (unsigned short)topLeft;
-            newMesh.indices[iIdx++] = (unsigned short)topRight;
-            newMesh.indices[iIdx++] = (unsigned short)bottomLeft;
-            
-            // Second triangle
-            newMesh.indices[iIdx++] = (unsigned short)topRight;
-            newMesh.indices[iIdx++] = (unsigned short)bottomRight;
-            newMesh.indices[iIdx++] = (unsigned short)bottomLeft;
+    Vector2 p = { 0.0f, 0.0f }, pu = { 0.0f, 0.0f }, pv = { 0.0f, 0.0f };
+    for (int j = 0; j < 4; j++) {
+        const Vector2 *row = &g->points[sv.index[j] * g->columns];
+        for (int i = 0; i < 4; i++) {
+            Vector2 c = row[su.index[i]];
+            float w = sv.w[j] * su.w[i];
+            p.x += c.x * w;
+            p.y += c.y * w;
+            if (derivatives) {
+                float wu = sv.w[j] * du.w[i];
+                float wv = dv.w[j] * su.w[i];
+                pu.x += c.x * wu;
+                pu.y += c.y * wu;
+                pv.x += c.x * wv;
+                pv.y += c.y * wv;
+            }
+        }
+    }
+    if (derivatives) {
+        *dPdu = pu;
+        *dPdv = pv;
+    }
+    return p;
+}
+
+// Screen point -> (u, v) on the grid surface: Newton iterations from the nearest control
+// point. (-1, -1) if the point is not on the surface
+static Vector2 rm_UnmapPointGrid(const rm_ControlGrid *g, Vector2 p)
+{
+    int nearest = 0;
+    float nearestDist = FLT_MAX;
+    for (int k = 0; k < g->columns * g->rows; k++) {
+        float dx = g->points[k].x - p.x;
+        float dy = g->points[k].y - p.y;
+        float d = dx * dx + dy * dy;
+        if (d < nearestDist) {
+            nearestDist = d;
+            nearest = k;
+        }
+    }
+    float u = (float)(nearest % g->columns) / (float)(g->columns - 1);
+    float v = (float)(nearest / g->columns) / (float)(g->rows - 1);
+    
+    for (int iter = 0; iter < 16; iter++) {
+        Vector2 pu, pv;
+        Vector2 q = rm_EvaluateGrid(g, u, v, &pu, &pv);
+        Vector2 r = Vector2Subtract(q, p);
+        if (r.x * r.x + r.y * r.y <= RM_GRID_UNMAP_TOLERANCE * RM_GRID_UNMAP_TOLERANCE) {
+            return (Vector2){ u, v };
+        }
+        
+        // Solve [pu pv] * d = -r
+        float det = pu.x * pv.y - pv.x * pu.y;
+        if (fabsf(det) < RM_EPSILON) break;
+        float du = (-r.x * pv.y + pv.x * r.y) / det;
+        float dv = (-pu.x * r.y + r.x * pu.y) / det;
+        
+        // A step pushed against the border twice: the point is outside
+        float nu = rm_Clamp01(u + du);
+        float nv = rm_Clamp01(v + dv);
+        if (nu == u && nv == v) break;
+        u = nu;
+        v = nv;
+    }
+    
+    return (Vector2){ -1.0f, -1.0f };
+}
+
+// Build a columns x rows lattice: resampled from the current lattice, or flat on the quad
+static bool rm_ResizeGrid(RM_Surface *surface, int columns, int rows, bool resample)
+{
+    // Published copy: sized for the largest lattice, so readers never see it move
+    if (!surface->gridPublished) {
+        surface->gridPublished = (Vector2 *)RMMALLOC(RM_MAX_GRID_POINTS * RM_MAX_GRID_POINTS * sizeof(Vector2));
+        if (!surface->gridPublished) {
+            TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate published control grid");
+            return false;
+        }
+    }
+    
+    Vector2 *points = (Vector2 *)RMMALLOC(columns * rows * sizeof(Vector2));
+    if (!points) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate %dx%d control grid", columns, rows);
+        return false;
+    }
+    
+    rm_ControlGrid *g = &surface->grid;
+    RM_Quad q = surface->quad;
+    for (int j = 0; j < rows; j++) {
+        for (int i = 0; i < columns; i++) {
+            float u = (float)i / (float)(columns - 1);
+            float v = (float)j / (float)(rows - 1);
+            points[j * columns + i] = (resample && g->points) ? rm_EvaluateGrid(g, u, v, NULL, NULL) :
+                rm_BilinearInterpolation(q.topLeft, q.topRight, q.bottomLeft, q.bottomRight, u, v);
+        }
+    }
+    
+    if (g->points) RMFREE(g->points);
+    g->points = points;
+    g->columns = columns;
+    g->rows = rows;
+    rm_UpdateGridMetrics(g);
+    rm_ClearGridDirty(g);
+    return true;
+}
+
+static void rm_FreeGrid(RM_Surface *surface)
+{
+    if (surface->grid.points) RMFREE(surface->grid.points);
+    if (surface->gridPublished) RMFREE(surface->gridPublished);
+    surface->grid.points = NULL;
+    surface->gridPublished = NULL;
+}
+
+// Keep every control point at the same offset from the quad when the quad moves
+// (Catmull-Rom reproduces bilinear maps, so the warp follows the corners)
+static void rm_MoveGridWithQuad(rm_ControlGrid *g, RM_Quad from, RM_Quad to)
+{
+    if (!g->points) return;
+    
+    for (int j = 0; j < g->rows; j++) {
+        for (int i = 0; i < g->columns; i++) {
+            float u = (float)i / (float)(g->columns - 1);
+            float v = (float)j / (float)(g->rows - 1);
+            Vector2 a = rm_BilinearInterpolation(from.topLeft, from.topRight, from.bottomLeft, from.bottomRight, u, v);
+            Vector2 b = rm_BilinearInterpolation(to.topLeft, to.topRight, to.bottomLeft, to.bottomRight, u, v);
+            Vector2 *p = &g->points[j * g->columns + i];
+            p->x += b.x - a.x;
+            p->y += b.y - a.y;
+        }
+    }
+    rm_UpdateGridMetrics(g);
+}
+
+// Grid positions of the mesh vertices in [x0, x1] x [y0, y1] of a (cols+1) x (rows+1) mesh,
+// stride in floats. The 4 control rows around each mesh row are collapsed into one curve
+// first, so a vertex costs 4 weighted points instead of 16
+static void rm_ComputeGridPositions(const RM_Surface *surface, float *vertices, int stride, int cols, int rows, int x0, int y0, int x1, int y1)
+{
+    const rm_ControlGrid *g = &surface->grid;
+    rm_SplineSpan spanU[RM_MAX_MESH_RESOLUTION + 1];
+    Vector2 curve[RM_MAX_GRID_POINTS];
+    
+    for (int x = x0; x <= x1; x++) spanU[x] = rm_GetSplineSpan((float)x / (float)cols, g->columns, false);
+    
+    for (int y = y0; y <= y1; y++) {
+        rm_SplineSpan sv = rm_GetSplineSpan((float)y / (float)rows, g->rows, false);
+        const Vector2 *r0 = &g->points[sv.index[0] * g->columns];
+        const Vector2 *r1 = &g->points[sv.index[1] * g->columns];
+        const Vector2 *r2 = &g->points[sv.index[2] * g->columns];
+        const Vector2 *r3 = &g->points[sv.index[3] * g->columns];
+        for (int i = 0; i < g->columns; i++) {
+            curve[i].x = sv.w[0] * r0[i].x + sv.w[1] * r1[i].x + sv.w[2] * r2[i].x + sv.w[3] * r3[i].x;
+            curve[i].y = sv.w[0] * r0[i].y + sv.w[1] * r1[i].y + sv.w[2] * r2[i].y + sv.w[3] * r3[i].y;
+        }
+        
+        for (int x = x0; x <= x1; x++) {
+            const rm_SplineSpan *su = &spanU[x];
+            float *vertex = &vertices[(y * (cols + 1) + x) * stride];
+            vertex[0] = su->w[0] * curve[su->index[0]].x + su->w[1] * curve[su->index[1]].x +
+                        su->w[2] * curve[su->index[2]].x + su->w[3] * curve[su->index[3]].x;
+            vertex[1] = su->w[0] * curve[su->index[0]].y + su->w[1] * curve[su->index[1]].y +
+                        su->w[2] * curve[su->index[2]].y + su->w[3] * curve[su->index[3]].y;
+        }
+    }
+}
+
+// Mesh vertices whose position depends on the moved control points: each point weighs on
+// the two spans on either side of it
+static void rm_GetGridDirtyVertices(const rm_ControlGrid *g, int cols, int rows, int *x0, int *y0, int *x1, int *y1)
+{
+    int su0 = g->dirtyMinX - 2, su1 = g->dirtyMaxX + 1;
+    int sv0 = g->dirtyMinY - 2, sv1 = g->dirtyMaxY + 1;
+    if (su0 < 0) su0 = 0;
+    if (sv0 < 0) sv0 = 0;
+    if (su1 > g->columns - 2) su1 = g->columns - 2;
+    if (sv1 > g->rows - 2) sv1 = g->rows - 2;
+    
+    int spansU = g->columns - 1;
+    int spansV = g->rows - 1;
+    *x0 = su0 * cols / spansU;
+    *y0 = sv0 * rows / spansV;
+    *x1 = ((su1 + 1) * cols + spansU - 1) / spansU;
+    *y1 = ((sv1 + 1) * rows + spansV - 1) / spansV;
+    if (*x1 > cols) *x1 = cols;
+    if (*y1 > rows) *y1 = rows;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Adaptive Resolution
+//--------------------------------------------------------------------------------------------
+
+// Largest distance between a homography and the linear interpolation of its images over the
+// triangle (a, b, c), sampled at the edge midpoints and the centroid
+static float rm_HomographyTriangleError(const Matrix3x3 *H, const Vector2 uv[3], const Vector2 p[3])
+{
+    static const float weights[4][3] = {
+        { 0.5f, 0.5f, 0.0f }, { 0.0f, 0.5f, 0.5f }, { 0.5f, 0.0f, 0.5f },
+        { 1.0f/3.0f, 1.0f/3.0f, 1.0f/3.0f }
+    };
+    
+    float maxError = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        const float *w = weights[i];
+        Vector2 exact = rm_ApplyHomography(*H,
+            w[0] * uv[0].x + w[1] * uv[1].x + w[2] * uv[2].x,
+            w[0] * uv[0].y + w[1] * uv[1].y + w[2] * uv[2].y);
+        float dx = exact.x - (w[0] * p[0].x + w[1] * p[1].x + w[2] * p[2].x);
+        float dy = exact.y - (w[0] * p[0].y + w[1] * p[1].y + w[2] * p[2].y);
+        float error = sqrtf(dx * dx + dy * dy);
+        if (error > maxError) maxError = error;
+    }
+    return maxError;
+}
+
+// Mesh error of a homography on a cols x rows grid. The homogeneous w is affine in (u, v),
+// so magnification (and interpolation error) peaks in a corner cell: only those are sampled
+static float rm_HomographyMeshError(const Matrix3x3 *H, int cols, int rows)
+{
+    float du = 1.0f / (float)cols;
+    float dv = 1.0f / (float)rows;
+    float maxError = 0.0f;
+    
+    for (int corner = 0; corner < 4; corner++) {
+        float u0 = (corner & 1) ? 1.0f - du : 0.0f;
+        float v0 = (corner & 2) ? 1.0f - dv : 0.0f;
+        
+        Vector2 uv[4] = { { u0, v0 }, { u0 + du, v0 }, { u0, v0 + dv }, { u0 + du, v0 + dv } };
+        Vector2 p[4];
+        for (int i = 0; i < 4; i++) p[i] = rm_ApplyHomography(*H, uv[i].x, uv[i].y);
+        
+        // Same triangles as rm_GenerateGridIndices: (TL, TR, BL) and (TR, BR, BL)
+        Vector2 uvA[3] = { uv[0], uv[1], uv[2] }, pA[3] = { p[0], p[1], p[2] };
+        Vector2 uvB[3] = { uv[1], uv[3], uv[2] }, pB[3] = { p[1], p[3], p[2] };
+        float errorA = rm_HomographyTriangleError(H, uvA, pA);
+        float errorB = rm_HomographyTriangleError(H, uvB, pB);
+        if (errorA > maxError) maxError = errorA;
+        if (errorB > maxError) maxError = errorB;
+    }
+    return maxError;
+}
+
+// Mesh error of a bilinear map on a cols x rows grid (exact: only the twist term u*v is not
+// linear, it deviates by |g| * du * dv / 4 at each cell center)
+static float rm_BilinearMeshError(RM_Quad q, int cols, int rows)
+{
+    float gx = q.topLeft.x - q.topRight.x - q.bottomLeft.x + q.bottomRight.x;
+    float gy = q.topLeft.y - q.topRight.y - q.bottomLeft.y + q.bottomRight.y;
+    return sqrtf(gx * gx + gy * gy) / (4.0f * (float)cols * (float)rows);
+}
+
+// Mesh error of a control grid: a curve with second derivative up to M deviates from its
+// chords by at most M h^2 / 8 over a step h (in spans), plus the twist of the corner quad
+static float rm_GridMeshError(const rm_ControlGrid *g, int cols, int rows)
+{
+    float hu = (float)(g->columns - 1) / (float)cols;
+    float hv = (float)(g->rows - 1) / (float)rows;
+    RM_Quad corners = {
+        g->points[0], g->points[g->columns - 1],
+        g->points[g->columns * g->rows - 1], g->points[(g->rows - 1) * g->columns]
+    };
+    return (g->curvatureU * hu * hu + g->curvatureV * hv * hv) / 8.0f + rm_BilinearMeshError(corners, cols, rows);
+}
+
+static float rm_MeshError(const RM_Surface *surface, int cols, int rows)
+{
+    if (surface->mode == RM_MAP_HOMOGRAPHY) {
+        return rm_HomographyMeshError(&surface->transform.homography, cols, rows);
+    }
+    if (surface->mode == RM_MAP_GRID) {
+        return rm_GridMeshError(&surface->grid, cols, rows);
+    }
+    return rm_BilinearMeshError(surface->quad, cols, rows);
+}
+
+// RM_MESH_AUTO: smallest grid (in cells) whose error stays under the surface budget
+static void rm_UpdateAutoResolution(RM_Surface *surface)
+{
+    float budget = surface->meshErrorBudget;
+    int cols = surface->meshColumns;
+    int rows = surface->meshRows;
+    
+    // Current grid still fits and uses at least half the budget (error falls with the cell
+    // count, so it is close to the minimum): keep it, a dragged corner keeps its mesh
+    if (cols > 0 && rows > 0) {
+        float error = rm_MeshError(surface, cols, rows);
+        if (error <= budget && (error >= 0.5f * budget || cols * rows == 1)) return;
+        if (error > budget && cols == RM_MAX_AUTO_RESOLUTION && rows == RM_MAX_AUTO_RESOLUTION) return;
+    }
+    
+    int bestCols = RM_MAX_AUTO_RESOLUTION;
+    int bestRows = RM_MAX_AUTO_RESOLUTION;
+    
+    if (surface->mode != RM_MAP_BILINEAR) {
+        // Error decreases with both counts, so the fewest columns for a row count never grows
+        // with more rows: walk the staircase once instead of searching every row count
+        int c = RM_MAX_AUTO_RESOLUTION;
+        for (int r = 1; r <= RM_MAX_AUTO_RESOLUTION && r < bestCols * bestRows; r++) {
+            if (rm_MeshError(surface, c, r) > budget) continue;
+            while (c > 1 && rm_MeshError(surface, c - 1, r) <= budget) c--;
+            if (c * r < bestCols * bestRows) {
+                bestCols = c;
+                bestRows = r;
+            }
+        }
+    } else {
+        // Error only depends on cols * rows: square grid with enough cells
+        float cells = rm_BilinearMeshError(surface->quad, 1, 1) / budget;
+        int n = (int)ceilf(sqrtf(cells));
+        if (n < 1) n = 1;
+        if (n < RM_MAX_AUTO_RESOLUTION) {
+            bestCols = n;
+            bestRows = (int)ceilf(cells / (float)n);
+            if (bestRows < 1) bestRows = 1;
+        }
+    }
+    
+    if (cols != bestCols || rows != bestRows) {
+        TraceLog(LOG_DEBUG, "RAYMAP: Auto mesh resolution %dx%d (budget %.2f px)", bestCols, bestRows, budget);
+    }
+    surface->meshColumns = bestCols;
+    surface->meshRows = bestRows;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Vertex Streaming
+//--------------------------------------------------------------------------------------------
+
+// Accumulate one position upload into the surface statistics
+static void rm_RecordUpload(RM_Surface *surface, double seconds)
+{
+    RM_BufferStats *stats = &surface->bufferStats;
+    float ms = (float)(seconds * 1000.0);
+
+    stats->uploads++;
+    stats->totalUploadMs += ms;
+    if (ms > stats->maxUploadMs) stats->maxUploadMs = ms;
+    if (ms > RAYMAP_STALL_THRESHOLD_MS) stats->stalls++;
+}
+
+// Attribute layout of the vertex buffer currently bound, starting offset bytes in (row bands).
+// The default format only streams positions here, its texcoords and normals stay in their own
+// UploadMesh buffers
+static void rm_SetVertexLayout(RM_VertexFormat format, int offset)
+{
+    switch (format) {
+        case RM_VERTEX_COMPACT:
+            rlSetVertexAttribute(RM_ATTRIB_POSITION, 2, RL_FLOAT, false, (int)sizeof(rm_VertexCompact), RM_ATTRIB_OFFSET(offset));
+            rlSetVertexAttribute(RM_ATTRIB_TEXCOORD, 2, RL_FLOAT, false, (int)sizeof(rm_VertexCompact), RM_ATTRIB_OFFSET(offset + 2 * sizeof(float)));
+            rlEnableVertexAttribute(RM_ATTRIB_TEXCOORD);
+            break;
+        case RM_VERTEX_COMPACT16:
+            rlSetVertexAttribute(RM_ATTRIB_POSITION, 2, RM_GL_UNSIGNED_SHORT, true, (int)sizeof(rm_VertexCompact16), RM_ATTRIB_OFFSET(offset));
+            rlSetVertexAttribute(RM_ATTRIB_TEXCOORD, 2, RM_GL_UNSIGNED_SHORT, true, (int)sizeof(rm_VertexCompact16), RM_ATTRIB_OFFSET(offset + 2 * sizeof(unsigned short)));
+            rlEnableVertexAttribute(RM_ATTRIB_TEXCOORD);
+            break;
+        default:
+            rlSetVertexAttribute(RM_ATTRIB_POSITION, 3, RL_FLOAT, false, 0, RM_ATTRIB_OFFSET(offset));
+            break;
+    }
+    rlEnableVertexAttribute(RM_ATTRIB_POSITION);
+}
+
+// Vertex array, position buffer and CPU data rewritten when the quad changes
+static void rm_GetVertexStream(RM_Surface *surface, unsigned int *vaoId, unsigned int *vboId, void **data, int *size)
+{
+    if (surface->meshBuiltFormat == RM_VERTEX_DEFAULT) {
+        *vaoId = surface->mesh.vaoId;
+        *vboId = surface->mesh.vboId ? surface->mesh.vboId[0] : 0;
+        *data = surface->mesh.vertices;
+        *size = surface->mesh.vertexCount * 3 * (int)sizeof(float);
+    } else {
+        *vaoId = (surface->compact.bandCount > 0) ? surface->compact.bands[0].vaoId : surface->compact.vaoId;
+        *vboId = surface->compact.vboId;
+        *data = surface->compact.vertices;
+        *size = surface->compact.vertexCount * surface->compact.stride;
+    }
+}
+
+// Point a VAO's vertex attributes at another buffer with the same layout
+static void rm_BindVertexBuffer(unsigned int vaoId, unsigned int vboId, RM_VertexFormat format, int offset)
+{
+    rlEnableVertexArray(vaoId);
+    rlEnableVertexBuffer(vboId);
+    rm_SetVertexLayout(format, offset);
+    rlDisableVertexArray();
+}
+
+// Point the surface mesh (every row band of it) at another buffer with the same layout
+static void rm_BindMeshVertexBuffer(RM_Surface *surface, unsigned int vaoId, unsigned int vboId)
+{
+    const rm_CompactMesh *c = &surface->compact;
+    
+    if (surface->meshBuiltFormat != RM_VERTEX_DEFAULT && c->bandCount > 0) {
+        for (int i = 0; i < c->bandCount; i++) {
+            rm_BindVertexBuffer(c->bands[i].vaoId, vboId, c->format, c->bands[i].firstVertex * c->stride);
+        }
+        return;
+    }
+    rm_BindVertexBuffer(vaoId, vboId, surface->meshBuiltFormat, 0);
+}
+
+// Release the position ring, optionally giving the VAO back its own vertex buffer
+static void rm_UnloadPositionRing(RM_Surface *surface, bool rebind)
+{
+    if (surface->positionRing[0] == 0) return;
+
+    if (rebind) {
+        unsigned int vaoId, vboId;
+        void *data;
+        int size;
+        rm_GetVertexStream(surface, &vaoId, &vboId, &data, &size);
+        if (vaoId > 0 && vboId > 0) rm_BindMeshVertexBuffer(surface, vaoId, vboId);
+    }
+    for (int i = 0; i < RAYMAP_DYNAMIC_SEGMENTS; i++) {
+        rlUnloadVertexBuffer(surface->positionRing[i]);
+        surface->positionRing[i] = 0;
+    }
+    surface->ringSegment = 0;
+}
+
+// Upload mesh positions to the next ring segment and draw from it. The segment written now
+// was last read RAYMAP_DYNAMIC_SEGMENTS draws ago, so the driver never has to wait for the
+// GPU to finish with it (rlgl exposes no fences, the ring depth is the guard)
+static void rm_StreamMeshPositions(RM_Surface *surface)
+{
+    unsigned int vaoId, vboId;
+    void *data;
+    int size;
+    rm_GetVertexStream(surface, &vaoId, &vboId, &data, &size);
+
+    if (surface->positionRing[0] == 0) {
+        for (int i = 0; i < RAYMAP_DYNAMIC_SEGMENTS; i++) {
+            surface->positionRing[i] = rlLoadVertexBuffer(data, size, true);
+        }
+        surface->ringSegment = 0;
+        TraceLog(LOG_DEBUG, "RAYMAP: Position ring created [%d x %d bytes]", RAYMAP_DYNAMIC_SEGMENTS, size);
+    }
+
+    surface->ringSegment = (surface->ringSegment + 1) % RAYMAP_DYNAMIC_SEGMENTS;
+    unsigned int segmentId = surface->positionRing[surface->ringSegment];
+
+    double start = GetTime();
+    rlUpdateVertexBuffer(segmentId, data, size, 0);
+    rm_RecordUpload(surface, GetTime() - start);
+
+    rm_BindMeshVertexBuffer(surface, vaoId, segmentId);
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Index Buffer Cache
+//--------------------------------------------------------------------------------------------
+
+// Mesh topology only depends on the grid resolution, so all surfaces share one index buffer
+// per (cols, rows). Render thread only, like every other GL resource
+static rm_IndexBuffer *rm_indexCache = NULL;
+
+// Two triangles per grid cell
+static void rm_GenerateGridIndices(unsigned short *indices, int cols, int rows)
+{
+    int iIdx = 0;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int topLeft = y * (cols + 1) + x;
+            int topRight = topLeft + 1;
+            int bottomLeft = (y + 1) * (cols + 1) + x;
+            int bottomRight = bottomLeft + 1;
+            
+            // First triangle
+            indices[iIdx++] = (unsigned short)topLeft;
+            indices[iIdx++] = (unsigned short)topRight;
+            indices[iIdx++] = (unsigned short)bottomLeft;
+            
+            // Second triangle
+            indices[iIdx++] = (unsigned short)topRight;
+            indices[iIdx++] = (unsigned short)bottomRight;
+            indices[iIdx++] = (unsigned short)bottomLeft;
+        }
+    }
+}
+
+// Get the shared index buffer of a grid resolution, creating it on first use
+static rm_IndexBuffer *rm_AcquireIndexBuffer(int cols, int rows)
+{
+    for (rm_IndexBuffer *entry = rm_indexCache; entry; entry = entry->next) {
+        if (entry->cols == cols && entry->rows == rows) {
+            entry->refCount++;
+            return entry;
+        }
+    }
+    
+    rm_IndexBuffer *entry = (rm_IndexBuffer *)RMCALLOC(1, sizeof(rm_IndexBuffer));
+    if (!entry) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate index buffer");
+        return NULL;
+    }
+    entry->cols = cols;
+    entry->rows = rows;
+    entry->indexCount = cols * rows * 6;
+    entry->indices = (unsigned short *)RMCALLOC(entry->indexCount, sizeof(unsigned short));
+    if (!entry->indices) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate index buffer");
+        RMFREE(entry);
+        return NULL;
+    }
+    rm_GenerateGridIndices(entry->indices, cols, rows);
+    
+    // No VAO bound: the element buffer binding is VAO state, each mesh attaches it itself
+    rlDisableVertexArray();
+    entry->eboId = rlLoadVertexBufferElement(entry->indices, entry->indexCount * (int)sizeof(unsigned short), false);
+    if (entry->eboId == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to upload index buffer to GPU");
+        RMFREE(entry->indices);
+        RMFREE(entry);
+        return NULL;
+    }
+    
+    entry->refCount = 1;
+    entry->next = rm_indexCache;
+    rm_indexCache = entry;
+    TraceLog(LOG_DEBUG, "RAYMAP: Index buffer created [%dx%d, %d indices]", cols, rows, entry->indexCount);
+    return entry;
+}
+
+// Drop one reference, the buffer is freed with its last mesh
+static void rm_ReleaseIndexBuffer(rm_IndexBuffer *buffer)
+{
+    if (!buffer) return;
+    if (--buffer->refCount > 0) return;
+    
+    for (rm_IndexBuffer **link = &rm_indexCache; *link; link = &(*link)->next) {
+        if (*link == buffer) {
+            *link = buffer->next;
+            break;
+        }
+    }
+    TraceLog(LOG_DEBUG, "RAYMAP: Index buffer released [%dx%d]", buffer->cols, buffer->rows);
+    if (buffer->gridVaoId > 0) rlUnloadVertexArray(buffer->gridVaoId);
+    if (buffer->gridVboId > 0) rlUnloadVertexBuffer(buffer->gridVboId);
+    rlUnloadVertexBuffer(buffer->eboId);
+    RMFREE(buffer->indices);
+    RMFREE(buffer);
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Render Texture Atlas
+//--------------------------------------------------------------------------------------------
+
+// Atlas pages, shared by all atlas surfaces
+static rm_AtlasPage *rm_atlasPages = NULL;
+
+// Lowest y at which a width-wide region fits on the skyline from node index (-1 if none)
+static int rm_SkylineFit(const rm_AtlasPage *page, int index, int width, int height)
+{
+    int x = page->nodes[index].x;
+    if (x + width > RAYMAP_ATLAS_SIZE) return -1;
+    
+    int y = 0;
+    int widthLeft = width;
+    for (int i = index; widthLeft > 0; i++) {
+        if (page->nodes[i].y > y) y = page->nodes[i].y;
+        if (y + height > RAYMAP_ATLAS_SIZE) return -1;
+        widthLeft -= page->nodes[i].width;
+    }
+    return y;
+}
+
+// Bottom-left skyline packing: place at the lowest top edge, raise the skyline under it
+static bool rm_SkylinePack(rm_AtlasPage *page, int width, int height, int *outX, int *outY)
+{
+    int best = -1, bestX = 0, bestY = 0, bestTop = RAYMAP_ATLAS_SIZE + 1;
+    for (int i = 0; i < page->nodeCount; i++) {
+        int y = rm_SkylineFit(page, i, width, height);
+        if (y >= 0 && y + height < bestTop) {
+            best = i;
+            bestX = page->nodes[i].x;
+            bestY = y;
+            bestTop = y + height;
+        }
+    }
+    if (best < 0 || page->nodeCount == RAYMAP_ATLAS_SIZE) return false;
+    
+    // New segment on top of the region, then trim the segments it covers
+    memmove(&page->nodes[best + 1], &page->nodes[best], (page->nodeCount - best) * sizeof(rm_SkylineNode));
+    page->nodes[best] = (rm_SkylineNode){ bestX, bestTop, width };
+    page->nodeCount++;
+    
+    for (int i = best + 1; i < page->nodeCount; i++) {
+        rm_SkylineNode *prev = &page->nodes[i - 1];
+        rm_SkylineNode *node = &page->nodes[i];
+        int overlap = prev->x + prev->width - node->x;
+        if (overlap <= 0) break;
+        
+        node->x += overlap;
+        node->width -= overlap;
+        if (node->width > 0) break;
+        memmove(node, node + 1, (page->nodeCount - i - 1) * sizeof(rm_SkylineNode));
+        page->nodeCount--;
+        i--;
+    }
+    
+    // Merge neighbours at the same height
+    for (int i = 0; i + 1 < page->nodeCount; i++) {
+        if (page->nodes[i].y != page->nodes[i + 1].y) continue;
+        page->nodes[i].width += page->nodes[i + 1].width;
+        memmove(&page->nodes[i + 1], &page->nodes[i + 2], (page->nodeCount - i - 2) * sizeof(rm_SkylineNode));
+        page->nodeCount--;
+        i--;
+    }
+    
+    *outX = bestX;
+    *outY = bestY;
+    return true;
+}
+
+// Reuse a released region the size fits in (first fit, the region is not split)
+static bool rm_AtlasReuse(rm_AtlasPage *page, int width, int height, int *outX, int *outY)
+{
+    for (int i = 0; i < page->freeCount; i++) {
+        Rectangle r = page->freeRects[i];
+        if (width > (int)r.width || height > (int)r.height) continue;
+        
+        *outX = (int)r.x;
+        *outY = (int)r.y;
+        page->freeRects[i] = page->freeRects[--page->freeCount];
+        return true;
+    }
+    return false;
+}
+
+static rm_AtlasPage *rm_LoadAtlasPage(void)
+{
+    rm_AtlasPage *page = (rm_AtlasPage *)RMCALLOC(1, sizeof(rm_AtlasPage));
+    if (!page) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate atlas page");
+        return NULL;
+    }
+    
+    page->nodes = (rm_SkylineNode *)RMMALLOC(RAYMAP_ATLAS_SIZE * sizeof(rm_SkylineNode));
+    page->target = LoadRenderTexture(RAYMAP_ATLAS_SIZE, RAYMAP_ATLAS_SIZE);
+    if (!page->nodes || page->target.id == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to create %dx%d atlas page", RAYMAP_ATLAS_SIZE, RAYMAP_ATLAS_SIZE);
+        if (page->target.id > 0) UnloadRenderTexture(page->target);
+        if (page->nodes) RMFREE(page->nodes);
+        RMFREE(page);
+        return NULL;
+    }
+    page->nodes[0] = (rm_SkylineNode){ 0, 0, RAYMAP_ATLAS_SIZE };
+    page->nodeCount = 1;
+    
+    // Padding texels stay transparent
+    BeginTextureMode(page->target);
+        ClearBackground(BLANK);
+    EndTextureMode();
+    
+    page->next = rm_atlasPages;
+    rm_atlasPages = page;
+    TraceLog(LOG_DEBUG, "RAYMAP: Atlas page created [%dx%d, ID %u]", RAYMAP_ATLAS_SIZE, RAYMAP_ATLAS_SIZE, page->target.id);
+    return page;
+}
+
+// Find room for a width x height region, on a new page if all are full
+static rm_AtlasPage *rm_AcquireAtlasRegion(int width, int height, Rectangle *rect)
+{
+    int paddedWidth = width + RM_ATLAS_PADDING;
+    int paddedHeight = height + RM_ATLAS_PADDING;
+    if (paddedWidth > RAYMAP_ATLAS_SIZE || paddedHeight > RAYMAP_ATLAS_SIZE) return NULL;
+    
+    int x = 0, y = 0;
+    rm_AtlasPage *page = rm_atlasPages;
+    for (; page; page = page->next) {
+        if (rm_AtlasReuse(page, paddedWidth, paddedHeight, &x, &y)) break;
+        if (rm_SkylinePack(page, paddedWidth, paddedHeight, &x, &y)) break;
+    }
+    
+    if (!page) {
+        page = rm_LoadAtlasPage();
+        if (!page || !rm_SkylinePack(page, paddedWidth, paddedHeight, &x, &y)) return NULL;
+    }
+    
+    page->refCount++;
+    *rect = (Rectangle){ (float)x, (float)y, (float)width, (float)height };
+    return page;
+}
+
+static void rm_ReleaseAtlasRegion(rm_AtlasPage *page, Rectangle rect)
+{
+    if (--page->refCount > 0) {
+        // Kept for surfaces of the same size or smaller (lost if the list is full)
+        if (page->freeCount < RM_ATLAS_MAX_FREE) {
+            page->freeRects[page->freeCount++] = (Rectangle){ rect.x, rect.y,
+                rect.width + RM_ATLAS_PADDING, rect.height + RM_ATLAS_PADDING };
+        }
+        return;
+    }
+    
+    for (rm_AtlasPage **link = &rm_atlasPages; *link; link = &(*link)->next) {
+        if (*link == page) {
+            *link = page->next;
+            break;
+        }
+    }
+    TraceLog(LOG_DEBUG, "RAYMAP: Atlas page unloaded [ID %u]", page->target.id);
+    UnloadRenderTexture(page->target);
+    RMFREE(page->nodes);
+    RMFREE(page);
+}
+
+// Texture coordinates of a surface point (u, v in 0..1, v down), V flipped for raylib and
+// remapped to the atlas region
+static Vector2 rm_SurfaceTexcoord(const RM_Surface *surface, float u, float v)
+{
+    if (!surface->atlasPage) return (Vector2){ u, 1.0f - v };
+    
+    Rectangle r = surface->atlasRect;
+    float size = (float)RAYMAP_ATLAS_SIZE;
+    return (Vector2){ (r.x + u * r.width) / size, (r.y + (1.0f - v) * r.height) / size };
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - GPU Warp
+//--------------------------------------------------------------------------------------------
+
+// Warp shader: the mesh is the unit (u, v) grid, the vertex shader maps it to screen space
+// with the surface homography (rows of H) or the four bilinear corners.
+// Texcoords are projective (s, t, q) = (u, 1 - v, 1) / w: they stay linear in screen space
+// under a homography, so the per-fragment divide is exact on a single cell
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    #define RM_GLSL_VERTEX_HEADER   "#version 100\nattribute vec2 vertexPosition;\nattribute vec2 vertexTexCoord;\nvarying vec3 fragTexCoord;\n" \
+                                    "varying vec4 blendOwn;\nvarying vec4 blendOther[4];\n"
+    #define RM_GLSL_FRAGMENT_HEADER "#version 100\n#ifdef GL_FRAGMENT_PRECISION_HIGH\nprecision highp float;\n#else\nprecision mediump float;\n#endif\n" \
+                                    "varying vec3 fragTexCoord;\nvarying vec4 blendOwn;\nvarying vec4 blendOther[4];\n" \
+                                    "#define finalColor gl_FragColor\n#define textureProj texture2DProj\n"
+#else
+    #define RM_GLSL_VERTEX_HEADER   "#version 330\nin vec2 vertexPosition;\nin vec2 vertexTexCoord;\nout vec3 fragTexCoord;\n" \
+                                    "out vec4 blendOwn;\nout vec4 blendOther[4];\n"
+    #define RM_GLSL_FRAGMENT_HEADER "#version 330\nin vec3 fragTexCoord;\nin vec4 blendOwn;\nin vec4 blendOther[4];\nout vec4 finalColor;\n"
+#endif
+
+// Edge blending: signed distances (pixels, positive inside) to the edge lines of the surface
+// quad and of up to 4 (RM_MAX_BLEND_NEIGHBORS) overlapping quads. Distances are affine in
+// screen space, so computing them per vertex is exact. Unused quads have lines (0, 0, -1)
+#define RM_GLSL_BLEND_VERTEX \
+    "uniform vec3 blendEdges[20];\n" \
+    "vec4 blendDistances(int first, vec3 p)\n" \
+    "{\n" \
+    "    return vec4(dot(blendEdges[first], p), dot(blendEdges[first + 1], p), dot(blendEdges[first + 2], p), dot(blendEdges[first + 3], p));\n" \
+    "}\n" \
+    "void setBlendDistances(vec2 position)\n" \
+    "{\n" \
+    "    vec3 p = vec3(position, 1.0);\n" \
+    "    blendOwn = blendDistances(0, p);\n" \
+    "    blendOther[0] = blendDistances(4, p);\n" \
+    "    blendOther[1] = blendDistances(8, p);\n" \
+    "    blendOther[2] = blendDistances(12, p);\n" \
+    "    blendOther[3] = blendDistances(16, p);\n" \
+    "}\n"
+
+// Each quad weighs its depth inside the fragment (capped at the ramp width), the surface keeps
+// its share of the total. The share is light, the projector outputs share^(1/gamma)
+#define RM_GLSL_BLEND_FRAGMENT \
+    "uniform float blendWidth;\n" \
+    "uniform float blendGamma;\n" \
+    "float blendRamp(vec4 d)\n" \
+    "{\n" \
+    "    float inside = min(min(d.x, d.y), min(d.z, d.w));\n" \
+    "    return (blendWidth > 0.0)? clamp(inside/blendWidth, 0.0, 1.0) : max(inside, 0.0);\n" \
+    "}\n" \
+    "float blendWeight()\n" \
+    "{\n" \
+    "    if (blendGamma <= 0.0) return 1.0;\n" \
+    "    float own = blendRamp(blendOwn);\n" \
+    "    float total = own + blendRamp(blendOther[0]) + blendRamp(blendOther[1]) + blendRamp(blendOther[2]) + blendRamp(blendOther[3]);\n" \
+    "    return (total > 0.0)? pow(own/total, 1.0/blendGamma) : 1.0;\n" \
+    "}\n"
+
+static const char *rm_warpVertexShader = RM_GLSL_VERTEX_HEADER RM_GLSL_BLEND_VERTEX
+    "uniform mat4 mvp;\n"
+    "uniform vec3 warpHomography[3];\n"
+    "uniform vec2 warpCorners[4];\n"
+    "uniform int warpMode;\n"
+    "uniform vec4 warpTexRect;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 uv = vertexPosition;\n"
+    "    vec2 p;\n"
+    "    float w = 1.0;\n"
+    "    if (warpMode == 1) {\n"
+    "        vec3 uv1 = vec3(uv, 1.0);\n"
+    "        vec3 h = vec3(dot(warpHomography[0], uv1), dot(warpHomography[1], uv1), dot(warpHomography[2], uv1));\n"
+    "        if (abs(h.z) > 1e-4) w = h.z;\n"
+    "        p = h.xy/w;\n"
+    "    } else {\n"
+    "        p = mix(mix(warpCorners[0], warpCorners[1], uv.x), mix(warpCorners[3], warpCorners[2], uv.x), uv.y);\n"
+    "    }\n"
+    "    fragTexCoord = vec3(warpTexRect.xy + vec2(uv.x, 1.0 - uv.y)*warpTexRect.zw, 1.0)/w;\n"
+    "    setBlendDistances(p);\n"
+    "    gl_Position = mvp*vec4(p, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *rm_warpFragmentShader = RM_GLSL_FRAGMENT_HEADER RM_GLSL_BLEND_FRAGMENT
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 color = textureProj(texture0, fragTexCoord)*colDiffuse;\n"
+    "    finalColor = vec4(color.rgb*blendWeight(), color.a);\n"
+    "}\n";
+
+// Blend shader: CPU-built meshes (positions already warped) drawn with the warp fragment
+// shader. blendBounds maps COMPACT16 positions back to screen space
+static const char *rm_blendVertexShader = RM_GLSL_VERTEX_HEADER RM_GLSL_BLEND_VERTEX
+    "uniform mat4 mvp;\n"
+    "uniform vec4 blendBounds;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vec3(vertexTexCoord, 1.0);\n"
+    "    setBlendDistances(blendBounds.xy + vertexPosition*blendBounds.zw);\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 0.0, 1.0);\n"
+    "}\n";
+
+// Locations of the blend uniforms in a shader
+typedef struct {
+    int edgesLoc;
+    int widthLoc;
+    int gammaLoc;
+    int boundsLoc;                  // Blend shader only (-1 in the warp shader)
+} rm_BlendLocs;
+
+static rm_BlendLocs rm_GetBlendLocs(Shader shader)
+{
+    rm_BlendLocs locs;
+    locs.edgesLoc = GetShaderLocation(shader, "blendEdges");
+    locs.widthLoc = GetShaderLocation(shader, "blendWidth");
+    locs.gammaLoc = GetShaderLocation(shader, "blendGamma");
+    locs.boundsLoc = rlGetLocationUniform(shader.id, "blendBounds");
+    return locs;
+}
+
+// Compile a shader shared by many objects, or take one more reference to it. setup runs once
+// after compiling (uniform locations, constant uniforms)
+static bool rm_AcquireSharedShader(Shader *shader, int *refCount, const char *vs, const char *fs, const char *name, void (*setup)(Shader shader))
+{
+    if (*refCount > 0) {
+        (*refCount)++;
+        return true;
+    }
+    
+    Shader loaded = LoadShaderFromMemory(vs, fs);
+    
+    // raylib falls back to its default shader when compilation fails
+    if (loaded.id == 0 || loaded.id == rlGetShaderIdDefault()) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to compile %s shader", name);
+        return false;
+    }
+    
+    *shader = loaded;
+    *refCount = 1;
+    if (setup) setup(loaded);
+    TraceLog(LOG_DEBUG, "RAYMAP: Shader loaded [%s, ID %u]", name, loaded.id);
+    return true;
+}
+
+// Drop one reference, the last one unloads the shader
+static void rm_ReleaseSharedShader(Shader *shader, int *refCount, const char *name)
+{
+    if (*refCount <= 0) return;
+    if (--(*refCount) > 0) return;
+    
+    UnloadShader(*shader);
+    *shader = (Shader){ 0 };
+    TraceLog(LOG_DEBUG, "RAYMAP: Shader unloaded [%s]", name);
+}
+
+// Warp shader shared by all GPU warp surfaces, loaded with the first one
+typedef struct {
+    Shader shader;
+    int homographyLoc;
+    int cornersLoc;
+    int modeLoc;
+    int texRectLoc;
+    rm_BlendLocs blend;
+    int refCount;
+} rm_WarpShader;
+
+static rm_WarpShader rm_warpShader = { 0 };
+
+static void rm_SetupWarpShader(Shader shader)
+{
+    rm_warpShader.homographyLoc = GetShaderLocation(shader, "warpHomography");
+    rm_warpShader.cornersLoc = GetShaderLocation(shader, "warpCorners");
+    rm_warpShader.modeLoc = GetShaderLocation(shader, "warpMode");
+    rm_warpShader.texRectLoc = GetShaderLocation(shader, "warpTexRect");
+    rm_warpShader.blend = rm_GetBlendLocs(shader);
+}
+
+static bool rm_AcquireWarpShader(void)
+{
+    return rm_AcquireSharedShader(&rm_warpShader.shader, &rm_warpShader.refCount,
+                                  rm_warpVertexShader, rm_warpFragmentShader, "warp", rm_SetupWarpShader);
+}
+
+static void rm_ReleaseWarpShader(void)
+{
+    rm_ReleaseSharedShader(&rm_warpShader.shader, &rm_warpShader.refCount, "warp");
+}
+
+// Reduce a grid until it can be drawn with one 16-bit indexed call
+static void rm_FitIndexRange(int *cols, int *rows)
+{
+    while ((*cols + 1) * (*rows + 1) > UINT16_MAX) {
+        if (*cols >= *rows) (*cols)--;
+        else (*rows)--;
+    }
+}
+
+// GPU warp is requested and the mode has a shader path (control grids are CPU only)
+static inline bool rm_UsesGPUWarp(const RM_Surface *surface)
+{
+    return surface->gpuWarp && surface->mode != RM_MAP_GRID;
+}
+
+// Grid the surface mesh is built with. A GPU homography is exact with projective texcoords,
+// so it only needs the 4 corners: 2 triangles whatever the requested mesh resolution
+static void rm_GetBuildResolution(const RM_Surface *surface, int *cols, int *rows)
+{
+    if (rm_UsesGPUWarp(surface) && surface->mode == RM_MAP_HOMOGRAPHY) {
+        *cols = 1;
+        *rows = 1;
+        return;
+    }
+    *cols = surface->meshColumns;
+    *rows = surface->meshRows;
+    
+    // The shared warp grid is drawn in one call: keep it within 16-bit indices
+    if (rm_UsesGPUWarp(surface)) {
+        rm_FitIndexRange(cols, rows);
+        return;
+    }
+    
+    // Quad edited every frame: rewrite a coarse proxy instead of the full grid
+    if (surface->editing) {
+        if (*cols > RAYMAP_PROXY_RESOLUTION) *cols = RAYMAP_PROXY_RESOLUTION;
+        if (*rows > RAYMAP_PROXY_RESOLUTION) *rows = RAYMAP_PROXY_RESOLUTION;
+    }
+}
+
+// Layout the mesh is built with. raylib Mesh indices are 16-bit, so larger default-format
+// grids use the interleaved float layout, drawn in row bands
+static RM_VertexFormat rm_GetBuildFormat(const RM_Surface *surface, int cols, int rows)
+{
+    if (surface->vertexFormat == RM_VERTEX_DEFAULT && (cols + 1) * (rows + 1) > UINT16_MAX) {
+        return RM_VERTEX_COMPACT;
+    }
+    return surface->vertexFormat;
+}
+
+// Static unit grid of a resolution, stored next to its shared indices
+static bool rm_GetWarpGrid(rm_IndexBuffer *buffer)
+{
+    if (buffer->gridVboId > 0) return true;
+    
+    int cols = buffer->cols;
+    int rows = buffer->rows;
+    int vertexCount = (cols + 1) * (rows + 1);
+    float *grid = (float *)RMMALLOC(vertexCount * 2 * sizeof(float));
+    if (!grid) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate warp grid");
+        return false;
+    }
+    for (int y = 0, i = 0; y <= rows; y++) {
+        for (int x = 0; x <= cols; x++, i++) {
+            grid[i * 2 + 0] = (float)x / (float)cols;
+            grid[i * 2 + 1] = (float)y / (float)rows;
+        }
+    }
+    
+    buffer->gridVaoId = rlLoadVertexArray();
+    rlEnableVertexArray(buffer->gridVaoId);
+    buffer->gridVboId = rlLoadVertexBuffer(grid, vertexCount * 2 * (int)sizeof(float), false);
+    rlSetVertexAttribute(RM_ATTRIB_POSITION, 2, RL_FLOAT, false, 0, RM_ATTRIB_OFFSET(0));
+    rlEnableVertexAttribute(RM_ATTRIB_POSITION);
+    rlEnableVertexBufferElement(buffer->eboId);
+    rlDisableVertexArray();
+    RMFREE(grid);
+    
+    if (buffer->gridVboId == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to upload warp grid to GPU");
+        if (buffer->gridVaoId > 0) rlUnloadVertexArray(buffer->gridVaoId);
+        buffer->gridVaoId = 0;
+        return false;
+    }
+    
+    TraceLog(LOG_DEBUG, "RAYMAP: Warp grid created [%dx%d]", cols, rows);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Edge Blending
+//--------------------------------------------------------------------------------------------
+
+// Blended surfaces, linked through blendNext (overlaps are only searched among them)
+static RM_Surface *rm_blendSurfaces = NULL;
+static float rm_blendWidth = 0.0f;
+
+// Blend shader shared by all blended surfaces with a CPU-built mesh, loaded with the first one
+typedef struct {
+    Shader shader;
+    rm_BlendLocs locs;
+    int refCount;
+} rm_BlendShader;
+
+static rm_BlendShader rm_blendShader = { 0 };
+
+static void rm_SetupBlendShader(Shader shader)
+{
+    rm_blendShader.locs = rm_GetBlendLocs(shader);
+}
+
+static bool rm_AcquireBlendShader(void)
+{
+    return rm_AcquireSharedShader(&rm_blendShader.shader, &rm_blendShader.refCount,
+                                  rm_blendVertexShader, rm_warpFragmentShader, "blend", rm_SetupBlendShader);
+}
+
+static void rm_ReleaseBlendShader(void)
+{
+    rm_ReleaseSharedShader(&rm_blendShader.shader, &rm_blendShader.refCount, "blend");
+}
+
+// Take a surface out of the blended list
+static void rm_UnlinkBlendSurface(RM_Surface *surface)
+{
+    for (RM_Surface **link = &rm_blendSurfaces; *link; link = &(*link)->blendNext) {
+        if (*link == surface) {
+            *link = surface->blendNext;
+            break;
+        }
+    }
+    surface->blendNext = NULL;
+}
+
+// Edge lines (a, b, c) of a quad: a*x + b*y + c is the distance in pixels to the edge,
+// positive on the side of the quad center. A collapsed edge reuses the next corner
+static void rm_GetBlendLines(RM_Quad quad, float lines[4][3])
+{
+    Vector2 c[4] = { quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft };
+    Vector2 center = RM_GetQuadCenter(quad);
+    
+    for (int i = 0; i < 4; i++) {
+        Vector2 a = c[i];
+        Vector2 b = c[(i + 1) % 4];
+        for (int j = 2; j < 4 && Vector2Distance(a, b) <= RM_EPSILON; j++) b = c[(i + j) % 4];
+        
+        float length = Vector2Distance(a, b);
+        float nx = (length > RM_EPSILON) ? -(b.y - a.y) / length : 0.0f;
+        float ny = (length > RM_EPSILON) ? (b.x - a.x) / length : 0.0f;
+        float nc = -(nx * a.x + ny * a.y);
+        if (nx * center.x + ny * center.y + nc < 0.0f) {
+            nx = -nx;
+            ny = -ny;
+            nc = -nc;
+        }
+        lines[i][0] = nx;
+        lines[i][1] = ny;
+        lines[i][2] = nc;
+    }
+}
+
+// Keep the part of a polygon on the inner side of one line (Sutherland-Hodgman step)
+static int rm_ClipPolygonToLine(const Vector2 *in, int count, const float line[3], Vector2 *out)
+{
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        Vector2 a = in[i];
+        Vector2 b = in[(i + 1) % count];
+        float da = line[0] * a.x + line[1] * a.y + line[2];
+        float db = line[0] * b.x + line[1] * b.y + line[2];
+        
+        if (da >= 0.0f) out[n++] = a;
+        if ((da >= 0.0f) != (db >= 0.0f)) {
+            float t = da / (da - db);
+            out[n++] = (Vector2){ a.x + t * (b.x - a.x), a.y + t * (b.y - a.y) };
+        }
+    }
+    return n;
+}
+
+// Overlap of two quads (convex, as projector quads are), points in order. out holds 64 points:
+// every clip adds at most one point per crossing, which bounds non-convex input too
+static int rm_ClipQuads(RM_Quad subject, RM_Quad clip, Vector2 *out)
+{
+    float lines[4][3];
+    rm_GetBlendLines(clip, lines);
+    
+    Vector2 buffer[64];
+    Vector2 *in = out;
+    Vector2 *next = buffer;
+    in[0] = subject.topLeft;
+    in[1] = subject.topRight;
+    in[2] = subject.bottomRight;
+    in[3] = subject.bottomLeft;
+    int count = 4;
+    
+    for (int i = 0; i < 4 && count > 0; i++) {
+        count = rm_ClipPolygonToLine(in, count, lines[i], next);
+        Vector2 *swap = in;
+        in = next;
+        next = swap;
+    }
+    
+    // Four clips end in the caller's buffer
+    return count;
+}
+
+// Polygon area (shoelace formula), any winding
+static float rm_PolygonArea(const Vector2 *points, int count)
+{
+    float area = 0.0f;
+    for (int i = 0; i < count; i++) {
+        Vector2 a = points[i];
+        Vector2 b = points[(i + 1) % count];
+        area += a.x * b.y - b.x * a.y;
+    }
+    return fabsf(area) * 0.5f;
+}
+
+// Find the blended surfaces overlapping this one and store their edge lines. Runs again only
+// after a blended quad moved or the blended set changed (rm_blendGeneration)
+static void rm_UpdateBlendEdges(RM_Surface *surface)
+{
+    if (surface->blendGeneration == rm_blendGeneration) return;
+    
+    rm_GetBlendLines(surface->quad, surface->blendEdges);
+    for (int i = 4; i < (1 + RM_MAX_BLEND_NEIGHBORS) * 4; i++) {
+        surface->blendEdges[i][0] = 0.0f;
+        surface->blendEdges[i][1] = 0.0f;
+        surface->blendEdges[i][2] = -1.0f;
+    }
+    
+    // Largest overlaps win when more quads overlap than the shader takes
+    float areas[RM_MAX_BLEND_NEIGHBORS];
+    int count = 0;
+    int dropped = 0;
+    for (RM_Surface *other = rm_blendSurfaces; other; other = other->blendNext) {
+        if (other == surface) continue;
+        
+        Vector2 overlap[64];
+        float area = rm_PolygonArea(overlap, rm_ClipQuads(surface->quad, other->quad, overlap));
+        if (area < RM_BLEND_MIN_OVERLAP) continue;
+        
+        int slot = count;
+        if (count == RM_MAX_BLEND_NEIGHBORS) {
+            slot = 0;
+            for (int i = 1; i < count; i++) {
+                if (areas[i] < areas[slot]) slot = i;
+            }
+            dropped++;
+            if (area <= areas[slot]) continue;
+        } else {
+            count++;
+        }
+        areas[slot] = area;
+        rm_GetBlendLines(other->quad, surface->blendEdges + (1 + slot) * 4);
+    }
+    
+    if (dropped > 0) {
+        TraceLog(LOG_WARNING, "RAYMAP: Surface overlaps %d blended surfaces, the %d smallest overlaps are not blended",
+                 count + dropped, dropped);
+    }
+    surface->blendNeighborCount = count;
+    surface->blendGeneration = rm_blendGeneration;
+}
+
+// Send the blend state of a surface to the bound shader (a gamma of 0 turns blending off)
+static void rm_SetBlendUniforms(const RM_Surface *surface, const rm_BlendLocs *locs, Rectangle bounds)
+{
+    rlSetUniform(locs->gammaLoc, &surface->blendGamma, SHADER_UNIFORM_FLOAT, 1);
+    if (surface->blendGamma <= 0.0f) return;
+    
+    rlSetUniform(locs->edgesLoc, surface->blendEdges, SHADER_UNIFORM_VEC3, (1 + RM_MAX_BLEND_NEIGHBORS) * 4);
+    rlSetUniform(locs->widthLoc, &rm_blendWidth, SHADER_UNIFORM_FLOAT, 1);
+    if (locs->boundsLoc != -1) {
+        float values[4] = { bounds.x, bounds.y, bounds.width, bounds.height };
+        rlSetUniform(locs->boundsLoc, values, SHADER_UNIFORM_VEC4, 1);
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Mesh Generation
+//--------------------------------------------------------------------------------------------
+
+// Row kernels: every term that only depends on v is computed once per row, u is read from a
+// table (x / cols, exactly as per-vertex evaluation). Nothing accumulates along the row, so
+// positions stay within a few ulp of rm_ApplyHomography / rm_BilinearInterpolation and mesh
+// corners land exactly on the quad corners
+
+// Grid coordinates i / n for i = 0..n (same values as dividing per vertex)
+static void rm_GetGridSteps(float *t, int n)
+{
+    for (int i = 0; i <= n; i++) t[i] = (float)i / (float)n;
+}
+
+#if defined(RM_SIMD_SSE2)
+// Store 4 positions into vertices stride floats apart (the rest of each vertex is kept)
+static inline void rm_StorePositions4(float *out, int stride, __m128 x, __m128 y)
+{
+    __m128 lo = _mm_unpacklo_ps(x, y);
+    __m128 hi = _mm_unpackhi_ps(x, y);
+    _mm_storel_pi((__m64 *)&out[0], lo);
+    _mm_storeh_pi((__m64 *)&out[stride], lo);
+    _mm_storel_pi((__m64 *)&out[stride * 2], hi);
+    _mm_storeh_pi((__m64 *)&out[stride * 3], hi);
+}
+#endif
+
+// One bilinear row: p = (1 - u) * left + u * right, left/right on the quad side edges
+static void rm_WriteBilinearRow(float *out, int stride, const float *ut, int count, Vector2 left, Vector2 right)
+{
+    int x = 0;
+#if defined(RM_SIMD_AVX)
+    {
+        __m256 one = _mm256_set1_ps(1.0f);
+        __m256 lx = _mm256_set1_ps(left.x), ly = _mm256_set1_ps(left.y);
+        __m256 rx = _mm256_set1_ps(right.x), ry = _mm256_set1_ps(right.y);
+        for (; x + 8 <= count; x += 8) {
+            __m256 u = _mm256_loadu_ps(&ut[x]);
+            __m256 iu = _mm256_sub_ps(one, u);
+            __m256 px = _mm256_add_ps(_mm256_mul_ps(iu, lx), _mm256_mul_ps(u, rx));
+            __m256 py = _mm256_add_ps(_mm256_mul_ps(iu, ly), _mm256_mul_ps(u, ry));
+            rm_StorePositions4(&out[x * stride], stride, _mm256_castps256_ps128(px), _mm256_castps256_ps128(py));
+            rm_StorePositions4(&out[(x + 4) * stride], stride, _mm256_extractf128_ps(px, 1), _mm256_extractf128_ps(py, 1));
+        }
+    }
+#endif
+#if defined(RM_SIMD_SSE2)
+    {
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 lx = _mm_set1_ps(left.x), ly = _mm_set1_ps(left.y);
+        __m128 rx = _mm_set1_ps(right.x), ry = _mm_set1_ps(right.y);
+        for (; x + 4 <= count; x += 4) {
+            __m128 u = _mm_loadu_ps(&ut[x]);
+            __m128 iu = _mm_sub_ps(one, u);
+            __m128 px = _mm_add_ps(_mm_mul_ps(iu, lx), _mm_mul_ps(u, rx));
+            __m128 py = _mm_add_ps(_mm_mul_ps(iu, ly), _mm_mul_ps(u, ry));
+            rm_StorePositions4(&out[x * stride], stride, px, py);
+        }
+    }
+#endif
+    for (; x < count; x++) {
+        float u = ut[x];
+        float iu = 1.0f - u;
+        out[x * stride + 0] = iu * left.x + u * right.x;
+        out[x * stride + 1] = iu * left.y + u * right.y;
+    }
+}
+
+// One homography row: p = (h[.][0] * u + r) / (h[2][0] * u + rw), r = h[.][1] * v + h[.][2]
+static void rm_WriteHomographyRow(float *out, int stride, const float *ut, int count, const Matrix3x3 *h, float v)
+{
+    float ax = h->m[0][0], ay = h->m[1][0], aw = h->m[2][0];
+    float rx = h->m[0][1] * v + h->m[0][2];
+    float ry = h->m[1][1] * v + h->m[1][2];
+    float rw = h->m[2][1] * v + h->m[2][2];
+    
+    int x = 0;
+#if defined(RM_SIMD_AVX)
+    {
+        __m256 sign = _mm256_set1_ps(-0.0f), eps = _mm256_set1_ps(RM_EPSILON);
+        __m256 ax8 = _mm256_set1_ps(ax), ay8 = _mm256_set1_ps(ay), aw8 = _mm256_set1_ps(aw);
+        __m256 rx8 = _mm256_set1_ps(rx), ry8 = _mm256_set1_ps(ry), rw8 = _mm256_set1_ps(rw);
+        for (; x + 8 <= count; x += 8) {
+            __m256 u = _mm256_loadu_ps(&ut[x]);
+            __m256 px = _mm256_add_ps(_mm256_mul_ps(ax8, u), rx8);
+            __m256 py = _mm256_add_ps(_mm256_mul_ps(ay8, u), ry8);
+            __m256 w = _mm256_add_ps(_mm256_mul_ps(aw8, u), rw8);
+            __m256 divide = _mm256_cmp_ps(_mm256_andnot_ps(sign, w), eps, _CMP_GT_OQ);
+            px = _mm256_blendv_ps(px, _mm256_div_ps(px, w), divide);
+            py = _mm256_blendv_ps(py, _mm256_div_ps(py, w), divide);
+            rm_StorePositions4(&out[x * stride], stride, _mm256_castps256_ps128(px), _mm256_castps256_ps128(py));
+            rm_StorePositions4(&out[(x + 4) * stride], stride, _mm256_extractf128_ps(px, 1), _mm256_extractf128_ps(py, 1));
+        }
+    }
+#endif
+#if defined(RM_SIMD_SSE2)
+    {
+        __m128 sign = _mm_set1_ps(-0.0f), eps = _mm_set1_ps(RM_EPSILON);
+        __m128 ax4 = _mm_set1_ps(ax), ay4 = _mm_set1_ps(ay), aw4 = _mm_set1_ps(aw);
+        __m128 rx4 = _mm_set1_ps(rx), ry4 = _mm_set1_ps(ry), rw4 = _mm_set1_ps(rw);
+        for (; x + 4 <= count; x += 4) {
+            __m128 u = _mm_loadu_ps(&ut[x]);
+            __m128 px = _mm_add_ps(_mm_mul_ps(ax4, u), rx4);
+            __m128 py = _mm_add_ps(_mm_mul_ps(ay4, u), ry4);
+            __m128 w = _mm_add_ps(_mm_mul_ps(aw4, u), rw4);
+            __m128 divide = _mm_cmpgt_ps(_mm_andnot_ps(sign, w), eps);
+            px = _mm_or_ps(_mm_and_ps(divide, _mm_div_ps(px, w)), _mm_andnot_ps(divide, px));
+            py = _mm_or_ps(_mm_and_ps(divide, _mm_div_ps(py, w)), _mm_andnot_ps(divide, py));
+            rm_StorePositions4(&out[x * stride], stride, px, py);
+        }
+    }
+#endif
+    for (; x < count; x++) {
+        float u = ut[x];
+        float px = ax * u + rx;
+        float py = ay * u + ry;
+        float w = aw * u + rw;
+        if (fabsf(w) > RM_EPSILON) {
+            px /= w;
+            py /= w;
+        }
+        out[x * stride + 0] = px;
+        out[x * stride + 1] = py;
+    }
+}
+
+// Write deformed vertex positions (x, y) for a (cols+1) x (rows+1) grid, stride in floats.
+// Anything else in the vertex (z, texcoords) is left untouched
+static void rm_ComputeMeshPositions(const RM_Surface *surface, float *vertices, int stride, int cols, int rows)
+{
+    if (surface->mode == RM_MAP_GRID) {
+        rm_ComputeGridPositions(surface, vertices, stride, cols, rows, 0, 0, cols, rows);
+        return;
+    }
+    
+    float ut[RM_MAX_MESH_RESOLUTION + 1];
+    rm_GetGridSteps(ut, cols);
+    
+    // Homography was computed with the quad (the writer thread owns surface->transform)
+    RM_Quad q = surface->quad;
+    
+    for (int y = 0; y <= rows; y++) {
+        float v = (float)y / (float)rows;
+        float iv = 1.0f - v;
+        float *row = &vertices[y * (cols + 1) * stride];
+        
+        if (surface->mode == RM_MAP_HOMOGRAPHY) {
+            rm_WriteHomographyRow(row, stride, ut, cols + 1, &surface->transform.homography, v);
+        } else {
+            Vector2 left = { iv * q.topLeft.x + v * q.bottomLeft.x, iv * q.topLeft.y + v * q.bottomLeft.y };
+            Vector2 right = { iv * q.topRight.x + v * q.bottomRight.x, iv * q.topRight.y + v * q.bottomRight.y };
+            rm_WriteBilinearRow(row, stride, ut, cols + 1, left, right);
+        }
+    }
+}
+
+// Bounds the 16-bit positions are normalized to
+static void rm_FitCompact16Bounds(rm_CompactMesh *c)
+{
+    float minX = c->positions[0], maxX = c->positions[0];
+    float minY = c->positions[1], maxY = c->positions[1];
+    for (int i = 1; i < c->vertexCount; i++) {
+        float px = c->positions[i * 2 + 0];
+        float py = c->positions[i * 2 + 1];
+        if (px < minX) minX = px;
+        if (px > maxX) maxX = px;
+        if (py < minY) minY = py;
+        if (py > maxY) maxY = py;
+    }
+    float width = (maxX - minX > 0.0f) ? (maxX - minX) : 1.0f;
+    float height = (maxY - minY > 0.0f) ? (maxY - minY) : 1.0f;
+    c->bounds = (Rectangle){ minX, minY, width, height };
+}
+
+// Encode float positions of vertices [first, last] into the 16-bit buffer
+static void rm_EncodeCompact16Positions(rm_CompactMesh *c, int first, int last)
+{
+    rm_VertexCompact16 *vertices = (rm_VertexCompact16 *)c->vertices;
+    float sx = 65535.0f / c->bounds.width;
+    float sy = 65535.0f / c->bounds.height;
+    
+    for (int i = first; i <= last; i++) {
+        vertices[i].x = (unsigned short)((c->positions[i * 2 + 0] - c->bounds.x) * sx + 0.5f);
+        vertices[i].y = (unsigned short)((c->positions[i * 2 + 1] - c->bounds.y) * sy + 0.5f);
+    }
+}
+
+// Fill the interleaved buffer of a compact mesh (texcoords only on first build)
+static void rm_WriteCompactVertices(const RM_Surface *surface, rm_CompactMesh *c, int cols, int rows, bool texcoords)
+{
+    if (c->format == RM_VERTEX_COMPACT) {
+        rm_VertexCompact *vertices = (rm_VertexCompact *)c->vertices;
+        rm_ComputeMeshPositions(surface, &vertices[0].x, 4, cols, rows);
+        
+        if (texcoords) {
+            float ut[RM_MAX_MESH_RESOLUTION + 1];
+            rm_GetGridSteps(ut, cols);
+            for (int y = 0, i = 0; y <= rows; y++) {
+                float v = (float)y / (float)rows;
+                for (int x = 0; x <= cols; x++, i++) {
+                    Vector2 uv = rm_SurfaceTexcoord(surface, ut[x], v);
+                    vertices[i].u = uv.x;
+                    vertices[i].v = uv.y;
+                }
+            }
+        }
+        return;
+    }
+    
+    // 16-bit positions are normalized to the mesh bounds, the draw transform scales them back
+    rm_VertexCompact16 *vertices = (rm_VertexCompact16 *)c->vertices;
+    rm_ComputeMeshPositions(surface, c->positions, 2, cols, rows);
+    rm_FitCompact16Bounds(c);
+    rm_EncodeCompact16Positions(c, 0, c->vertexCount - 1);
+    
+    if (texcoords) {
+        float ut[RM_MAX_MESH_RESOLUTION + 1];
+        rm_GetGridSteps(ut, cols);
+        for (int y = 0, i = 0; y <= rows; y++) {
+            float v = (float)y / (float)rows;
+            for (int x = 0; x <= cols; x++, i++) {
+                Vector2 uv = rm_SurfaceTexcoord(surface, ut[x], v);
+                vertices[i].u = (unsigned short)(uv.x * 65535.0f + 0.5f);
+                vertices[i].v = (unsigned short)(uv.y * 65535.0f + 0.5f);
+            }
+        }
+    }
+}
+
+static void rm_UnloadCompactMesh(rm_CompactMesh *c)
+{
+    for (int i = 0; i < c->bandCount; i++) {
+        if (c->bands[i].vaoId > 0) rlUnloadVertexArray(c->bands[i].vaoId);
+        rm_ReleaseIndexBuffer(c->bands[i].indexBuffer);
+    }
+    if (c->bands) RMFREE(c->bands);
+    if (c->vaoId > 0) rlUnloadVertexArray(c->vaoId);
+    if (c->vboId > 0) rlUnloadVertexBuffer(c->vboId);
+    if (c->vertices) RMFREE(c->vertices);
+    if (c->positions) RMFREE(c->positions);
+    *c = (rm_CompactMesh){ 0 };
+}
+
+// Release whichever mesh the surface currently holds, and its index buffer reference
+static void rm_UnloadSurfaceMesh(RM_Surface *surface)
+{
+    if (surface->mesh.vertices) {
+        // Shared indices are not owned by the mesh
+        surface->mesh.indices = NULL;
+        surface->mesh.vboId[RM_MESH_BUFFER_INDICES] = 0;
+        UnloadMesh(surface->mesh);
+        surface->mesh = (Mesh){ 0 };
+        TraceLog(LOG_DEBUG, "RAYMAP: Old mesh unloaded");
+    }
+    if (surface->compact.vboId > 0 || surface->compact.vertices) {
+        rm_UnloadCompactMesh(&surface->compact);
+        TraceLog(LOG_DEBUG, "RAYMAP: Old compact mesh unloaded");
+    }
+    if (surface->meshBuiltWarp) {
+        rm_ReleaseWarpShader();
+        surface->meshBuiltWarp = false;
+    }
+    rm_ReleaseIndexBuffer(surface->indexBuffer);
+    surface->indexBuffer = NULL;
+}
+
+// Split an uploaded grid into row bands of at most 65535 vertices. Bands share their boundary
+// row and reuse the index cache: a 512x512 grid draws as 5 bands with 2 shared index buffers
+static bool rm_BuildMeshBands(rm_CompactMesh *c, int cols, int rows)
+{
+    int maxBandRows = UINT16_MAX / (cols + 1) - 1;
+    int bandCount = (rows + maxBandRows - 1) / maxBandRows;
+    int bandRows = (rows + bandCount - 1) / bandCount;
+    
+    c->bands = (rm_MeshBand *)RMCALLOC(bandCount, sizeof(rm_MeshBand));
+    if (!c->bands) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate mesh bands");
+        return false;
+    }
+    
+    for (int i = 0; i < bandCount; i++) {
+        rm_MeshBand *band = &c->bands[i];
+        int firstRow = i * bandRows;
+        int count = (rows - firstRow < bandRows) ? rows - firstRow : bandRows;
+        
+        band->indexBuffer = rm_AcquireIndexBuffer(cols, count);
+        c->bandCount = i + 1;
+        if (!band->indexBuffer) return false;
+        
+        band->firstVertex = firstRow * (cols + 1);
+        band->vaoId = rlLoadVertexArray();
+        rlEnableVertexArray(band->vaoId);
+        rlEnableVertexBuffer(c->vboId);
+        rm_SetVertexLayout(c->format, band->firstVertex * c->stride);
+        rlEnableVertexBufferElement(band->indexBuffer->eboId);
+        rlDisableVertexArray();
+    }
+    
+    TraceLog(LOG_DEBUG, "RAYMAP: Mesh split into %d row bands [%d rows each]", bandCount, bandRows);
+    return true;
+}
+
+// Fill the vertex data of an interleaved mesh (CPU only, no GL calls)
+static bool rm_PrepareCompactMesh(const RM_Surface *surface, rm_CompactMesh *c, RM_VertexFormat format, int cols, int rows, int vertexCount)
+{
+    *c = (rm_CompactMesh){ 0 };
+    c->format = format;
+    c->vertexCount = vertexCount;
+    c->indexCount = cols * rows * 6;
+    c->stride = (c->format == RM_VERTEX_COMPACT16) ? (int)sizeof(rm_VertexCompact16) : (int)sizeof(rm_VertexCompact);
+    
+    c->vertices = RMCALLOC(vertexCount, c->stride);
+    if (c->format == RM_VERTEX_COMPACT16) c->positions = (float *)RMCALLOC(vertexCount * 2, sizeof(float));
+    
+    if (!c->vertices || (c->format == RM_VERTEX_COMPACT16 && !c->positions)) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate mesh memory");
+        rm_UnloadCompactMesh(c);
+        return false;
+    }
+    
+    rm_WriteCompactVertices(surface, c, cols, rows, true);
+    return true;
+}
+
+// Upload an interleaved mesh: one vertex buffer (xy + uv) plus the shared index buffer,
+// or row bands when indexBuffer is NULL (grid beyond 16-bit indices)
+static bool rm_UploadCompactMesh(rm_CompactMesh *c, const rm_IndexBuffer *indexBuffer, int cols, int rows)
+{
+    // Row bands: one buffer, one VAO per band
+    if (!indexBuffer) {
+        rlDisableVertexArray();
+        c->vboId = rlLoadVertexBuffer(c->vertices, c->vertexCount * c->stride, false);
+        if (c->vboId == 0 || !rm_BuildMeshBands(c, cols, rows)) {
+            TraceLog(LOG_ERROR, "RAYMAP: Failed to upload mesh to GPU");
+            rm_UnloadCompactMesh(c);
+            return false;
+        }
+        return true;
+    }
+    
+    // Upload vertices to GPU and attach the shared indices to the VAO
+    c->vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(c->vaoId);
+    c->vboId = rlLoadVertexBuffer(c->vertices, c->vertexCount * c->stride, false);
+    rm_SetVertexLayout(c->format, 0);
+    c->eboId = indexBuffer->eboId;
+    rlEnableVertexBufferElement(c->eboId);
+    rlDisableVertexArray();
+    
+    if (c->vboId == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to upload mesh to GPU");
+        rm_UnloadCompactMesh(c);
+        return false;
+    }
+    
+    return true;
+}
+
+// Free the vertex data of a mesh that was not committed
+static void rm_DiscardMesh(rm_MeshBuild *build)
+{
+    rm_CleanupMeshMemory(&build->mesh);
+    rm_UnloadCompactMesh(&build->compact);
+    build->ready = false;
+}
+
+// Compute the vertex data of a new mesh for the current quad and mapping mode. No GL calls
+// and no surface writes: RM_UpdateSurfaces runs it on worker threads
+static bool rm_PrepareMesh(const RM_Surface *surface, int cols, int rows, rm_MeshBuild *build)
+{
+    int vertexCount = (cols + 1) * (rows + 1);
+    
+    *build = (rm_MeshBuild){ 0 };
+    build->cols = cols;
+    build->rows = rows;
+    build->format = rm_GetBuildFormat(surface, cols, rows);
+    
+    // Compact formats: single interleaved buffer, no raylib Mesh
+    if (build->format != RM_VERTEX_DEFAULT) {
+        build->ready = rm_PrepareCompactMesh(surface, &build->compact, build->format, cols, rows, vertexCount);
+        return build->ready;
+    }
+    
+    // Allocate new mesh
+    if (!rm_AllocateMeshMemory(&build->mesh, vertexCount, cols * rows * 2)) {
+        return false; // Error already logged
+    }
+    
+    // Vertex positions (z stays 0 from calloc)
+    rm_ComputeMeshPositions(surface, build->mesh.vertices, 3, cols, rows);
+    
+    // Static attributes
+    float ut[RM_MAX_MESH_RESOLUTION + 1];
+    rm_GetGridSteps(ut, cols);
+    int vIdx = 0;
+    for (int y = 0; y <= rows; y++) {
+        float v = (float)y / (float)rows;
+        for (int x = 0; x <= cols; x++) {
+            // Texture coordinates
+            Vector2 uv = rm_SurfaceTexcoord(surface, ut[x], v);
+            build->mesh.texcoords[vIdx * 2 + 0] = uv.x;
+            build->mesh.texcoords[vIdx * 2 + 1] = uv.y;
+            
+            // Normals (all pointing towards +Z)
+            build->mesh.normals[vIdx * 3 + 0] = 0.0f;
+            build->mesh.normals[vIdx * 3 + 1] = 0.0f;
+            build->mesh.normals[vIdx * 3 + 2] = 1.0f;
+            
+            vIdx++;
+        }
+    }
+    
+    build->ready = true;
+    return true;
+}
+
+// Upload a prepared mesh and swap it in for the surface mesh (render thread). The build
+// is consumed: on failure its data is freed and the old mesh is kept
+static void rm_CommitMesh(RM_Surface *surface, rm_MeshBuild *build)
+{
+    int cols = build->cols;
+    int rows = build->rows;
+    
+    // Beyond 16-bit indices the mesh is drawn in row bands, each with its own index buffer
+    bool banded = ((cols + 1) * (rows + 1) > UINT16_MAX);
+    
+    // Shared topology, only vertex data is built per surface
+    rm_IndexBuffer *indexBuffer = NULL;
+    if (!banded) {
+        indexBuffer = rm_AcquireIndexBuffer(cols, rows);
+        if (!indexBuffer) {
+            rm_DiscardMesh(build);
+            return; // Error already logged, keep old mesh
+        }
+    }
+    
+    if (build->format != RM_VERTEX_DEFAULT) {
+        rm_CompactMesh *c = &build->compact;
+        if (!rm_UploadCompactMesh(c, indexBuffer, cols, rows)) {
+            rm_ReleaseIndexBuffer(indexBuffer);
+            return; // Error already logged, keep old mesh
+        }
+        
+        rm_UnloadPositionRing(surface, false);
+        rm_UnloadSurfaceMesh(surface);
+        
+        surface->compact = *c;
+        surface->indexBuffer = indexBuffer;
+        surface->meshBuiltFormat = c->format;
+        surface->meshBuiltColumns = cols;
+        surface->meshBuiltRows = rows;
+        surface->meshNeedsUpdate = false;
+        
+        TraceLog(LOG_INFO, "RAYMAP: Compact mesh generated successfully [%d vertices, %d bytes/vertex, %d draw calls]",
+                 c->vertexCount, c->stride, (c->bandCount > 0) ? c->bandCount : 1);
+        *build = (rm_MeshBuild){ 0 };
+        return;
+    }
+    
+    Mesh newMesh = build->mesh;
+    *build = (rm_MeshBuild){ 0 };
+    
+    // Upload vertex data to GPU (no indices: the mesh gets no private index buffer)
+    UploadMesh(&newMesh, false);
+
+    // CRITICAL : Check upload succeeded BEFORE destroying old
+    if (newMesh.vboId[0] == 0){
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to upload mesh to GPU");
+        rm_CleanupMeshMemory(&newMesh); // Clean up the failed mesh
+        rm_ReleaseIndexBuffer(indexBuffer);
+        return; // keep old mesh
+    }
+    
+    // Attach the shared indices (DrawMesh draws indexed because mesh.indices is set)
+    newMesh.indices = indexBuffer->indices;
+    newMesh.vboId[RM_MESH_BUFFER_INDICES] = indexBuffer->eboId;
+    if (rlEnableVertexArray(newMesh.vaoId)) {
+        rlEnableVertexBufferElement(indexBuffer->eboId);
+        rlDisableVertexArray();
+    }
+
+    // Upload succeeded -> safge destroy old mesh (ring was sized for it)
+    rm_UnloadPositionRing(surface, false);
+    rm_UnloadSurfaceMesh(surface);
+    
+    // replace newMesh
+    surface->mesh = newMesh;
+    surface->indexBuffer = indexBuffer;
+    surface->meshBuiltFormat = RM_VERTEX_DEFAULT;
+    surface->meshBuiltColumns = cols;
+    surface->meshBuiltRows = rows;
+    surface->meshNeedsUpdate = false;
+    
+    TraceLog(LOG_INFO, "RAYMAP: Mesh generated successfully [%d vertices, %d triangles]",
+             newMesh.vertexCount, newMesh.triangleCount);
+}
+
+// Generate deformed mesh based on current quad and mapping mode
+static void rm_GenerateBilinearMesh(RM_Surface *surface, int cols, int rows)
+{
+    if (!surface) {
+        TraceLog(LOG_ERROR, "RAYMAP: Cannot generate mesh for NULL surface");
+        return;
+    }
+    
+    // Calculate dimensions
+    if (cols < 1 || rows < 1 || cols > RM_MAX_MESH_RESOLUTION || rows > RM_MAX_MESH_RESOLUTION){
+        TraceLog(LOG_ERROR, "RAYMAP: Mesh resolution too hight [%dx%d > %dx%d]", cols, rows,
+                 RM_MAX_MESH_RESOLUTION, RM_MAX_MESH_RESOLUTION);
+        return;
+    }
+    
+    TraceLog(LOG_DEBUG, "RAYMAP: Generating mesh [%dx%d = %d vertices, %d triangles]",
+             cols, rows, (cols + 1) * (rows + 1), cols * rows * 2);
+    
+    // GPU warp: the shared unit grid is the whole mesh, the quad is passed as uniforms
+    // (rm_GetBuildResolution keeps GPU warp grids within 16-bit indices)
+    if (rm_UsesGPUWarp(surface) && (cols + 1) * (rows + 1) <= UINT16_MAX) {
+        rm_IndexBuffer *indexBuffer = rm_AcquireIndexBuffer(cols, rows);
+        if (!indexBuffer) {
+            return; // Error already logged, keep old mesh
+        }
+        if (rm_GetWarpGrid(indexBuffer) && rm_AcquireWarpShader()) {
+            rm_UnloadPositionRing(surface, false);
+            rm_UnloadSurfaceMesh(surface);
+            
+            surface->indexBuffer = indexBuffer;
+            surface->meshBuiltWarp = true;
+            surface->meshBuiltColumns = cols;
+            surface->meshBuiltRows = rows;
+            surface->meshNeedsUpdate = false;
+            
+            TraceLog(LOG_INFO, "RAYMAP: GPU warp grid ready [%dx%d]", cols, rows);
+            return;
+        }
+        TraceLog(LOG_WARNING, "RAYMAP: GPU warp unavailable, falling back to CPU mesh");
+        surface->gpuWarp = false;
+        rm_ReleaseIndexBuffer(indexBuffer);
+    }
+    
+    rm_MeshBuild build;
+    if (!rm_PrepareMesh(surface, cols, rows, &build)) {
+        return; // Error already logged, keep old mesh
+    }
+    rm_CommitMesh(surface, &build);
+}
+
+// Send rewritten vertex bytes [offset, offset + bytes) to the GPU. Dynamic surfaces need a
+// VAO to switch buffers and always stream the whole buffer (GLES2 without VAO updates in place)
+static void rm_UploadMeshVertices(RM_Surface *surface, unsigned int vaoId, unsigned int vboId, void *data, int offset, int bytes)
+{
+    if (surface->dynamic && vaoId > 0) {
+        rm_StreamMeshPositions(surface);
+        return;
+    }
+    
+    double start = GetTime();
+    rlUpdateVertexBuffer(vboId, (unsigned char *)data + offset, bytes, offset);
+    rm_RecordUpload(surface, GetTime() - start);
+}
+
+// Control points moved: recompute the mesh vertices they affect and upload the vertex range
+// holding them, from the first to the last affected vertex
+static void rm_UpdateGridVertices(RM_Surface *surface, int cols, int rows, unsigned int vaoId, unsigned int vboId, void *data, int size)
+{
+    int x0, y0, x1, y1;
+    rm_GetGridDirtyVertices(&surface->grid, cols, rows, &x0, &y0, &x1, &y1);
+    int first = y0 * (cols + 1) + x0;
+    int last = y1 * (cols + 1) + x1;
+    
+    if (surface->meshBuiltFormat == RM_VERTEX_DEFAULT) {
+        rm_ComputeGridPositions(surface, surface->mesh.vertices, 3, cols, rows, x0, y0, x1, y1);
+        rm_UploadMeshVertices(surface, vaoId, vboId, data, first * 3 * (int)sizeof(float), (last - first + 1) * 3 * (int)sizeof(float));
+        return;
+    }
+    
+    rm_CompactMesh *c = &surface->compact;
+    if (c->format == RM_VERTEX_COMPACT) {
+        rm_ComputeGridPositions(surface, &((rm_VertexCompact *)c->vertices)[0].x, 4, cols, rows, x0, y0, x1, y1);
+        rm_UploadMeshVertices(surface, vaoId, vboId, data, first * c->stride, (last - first + 1) * c->stride);
+        return;
+    }
+    
+    // 16-bit positions: a point leaving the mesh bounds changes the encoding of every vertex
+    rm_ComputeGridPositions(surface, c->positions, 2, cols, rows, x0, y0, x1, y1);
+    bool inside = true;
+    for (int y = y0; y <= y1 && inside; y++) {
+        for (int x = x0; x <= x1; x++) {
+            const float *p = &c->positions[(y * (cols + 1) + x) * 2];
+            if (p[0] < c->bounds.x || p[0] > c->bounds.x + c->bounds.width ||
+                p[1] < c->bounds.y || p[1] > c->bounds.y + c->bounds.height) {
+                inside = false;
+                break;
+            }
+        }
+    }
+    if (!inside) {
+        rm_FitCompact16Bounds(c);
+        rm_EncodeCompact16Positions(c, 0, c->vertexCount - 1);
+        rm_UploadMeshVertices(surface, vaoId, vboId, data, 0, size);
+        return;
+    }
+    rm_EncodeCompact16Positions(c, first, last);
+    rm_UploadMeshVertices(surface, vaoId, vboId, data, first * c->stride, (last - first + 1) * c->stride);
+}
+
+// Quad or mode changed: re-pick the grid (a GPU homography always uses one cell), then get
+// the grid the mesh is built with
+static void rm_GetUpdateResolution(RM_Surface *surface, int *cols, int *rows)
+{
+    if (surface->meshAuto && !(rm_UsesGPUWarp(surface) && surface->mode == RM_MAP_HOMOGRAPHY)) {
+        rm_UpdateAutoResolution(surface);
+    }
+    rm_GetBuildResolution(surface, cols, rows);
+}
+
+// Same grid and layout already on the GPU: only positions changed (quad drag)
+static bool rm_CanUpdateInPlace(RM_Surface *surface, int cols, int rows)
+{
+    unsigned int vaoId, vboId;
+    void *data;
+    int size;
+    rm_GetVertexStream(surface, &vaoId, &vboId, &data, &size);
+    
+    return !rm_UsesGPUWarp(surface) && !surface->meshBuiltWarp && data && vboId != 0 &&
+           surface->meshBuiltFormat == rm_GetBuildFormat(surface, cols, rows) &&
+           surface->meshBuiltColumns == cols && surface->meshBuiltRows == rows;
+}
+
+// Recompute every vertex position of the built mesh in its CPU copy (no GL calls)
+static void rm_RewriteMeshPositions(RM_Surface *surface, int cols, int rows)
+{
+    if (surface->meshBuiltFormat == RM_VERTEX_DEFAULT) {
+        rm_ComputeMeshPositions(surface, surface->mesh.vertices, 3, cols, rows);
+    } else {
+        rm_WriteCompactVertices(surface, &surface->compact, cols, rows, false);
+    }
+}
+
+// Send the rewritten CPU copy to the GPU and mark the mesh current
+static void rm_FinishMeshRewrite(RM_Surface *surface)
+{
+    unsigned int vaoId, vboId;
+    void *data;
+    int size;
+    rm_GetVertexStream(surface, &vaoId, &vboId, &data, &size);
+    
+    rm_UploadMeshVertices(surface, vaoId, vboId, data, 0, size);
+    surface->meshNeedsUpdate = false;
+    rm_ClearGridDirty(&surface->grid);
+}
+
+// Update mesh if dirty flag is set
+static void rm_EnsureMeshUpdated(RM_Surface *surface)
+{
+    if (!surface) {
+        TraceLog(LOG_WARNING, "RAYMAP: Cannot update NULL surface mesh");
+        return;
+    }
+    
+    // Moved control points only need part of the mesh (any other change rewrites all of it)
+    bool gridEdit = (surface->mode == RM_MAP_GRID && surface->grid.dirtyMaxX >= 0);
+    if (!surface->meshNeedsUpdate && !gridEdit) {
+        return;
+    }
+    
+    int cols, rows;
+    rm_GetUpdateResolution(surface, &cols, &rows);
+    
+    // GPU warp on the same grid: the quad is read at draw time, nothing to rebuild
+    if (rm_UsesGPUWarp(surface) && surface->meshBuiltWarp &&
+        surface->meshBuiltColumns == cols && surface->meshBuiltRows == rows) {
+        surface->meshNeedsUpdate = false;
+        return;
+    }
+    
+    // Same grid and layout already on the GPU: rewrite in place
+    if (rm_CanUpdateInPlace(surface, cols, rows)) {
+        if (!surface->meshNeedsUpdate) {
+            unsigned int vaoId, vboId;
+            void *data;
+            int size;
+            rm_GetVertexStream(surface, &vaoId, &vboId, &data, &size);
+            rm_UpdateGridVertices(surface, cols, rows, vaoId, vboId, data, size);
+            rm_ClearGridDirty(&surface->grid);
+            return;
+        }
+        
+        rm_RewriteMeshPositions(surface, cols, rows);
+        rm_FinishMeshRewrite(surface);
+        return;
+    }
+    
+    // A full rebuild covers any moved control points
+    rm_ClearGridDirty(&surface->grid);
+    TraceLog(LOG_DEBUG, "RAYMAP: Lazy mesh update triggered");
+    rm_GenerateBilinearMesh(surface, cols, rows);
+}
+
+// Enable a shader and set the uniforms DrawMesh sets for the default material (diffuse color,
+// model and MVP matrices). Our buffers have no color attribute: constant white like UploadMesh
+// does for color-less meshes
+static void rm_BeginShader(Shader shader, Color diffuse, Matrix model)
+{
+    rlEnableShader(shader.id);
+    
+    if (shader.locs[SHADER_LOC_COLOR_DIFFUSE] != -1) {
+        float values[4] = { diffuse.r / 255.0f, diffuse.g / 255.0f, diffuse.b / 255.0f, diffuse.a / 255.0f };
+        rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE], values, SHADER_UNIFORM_VEC4, 1);
+    }
+    
+    Matrix matModel = MatrixMultiply(model, rlGetMatrixTransform());
+    Matrix matModelView = MatrixMultiply(matModel, rlGetMatrixModelview());
+    if (shader.locs[SHADER_LOC_MATRIX_MODEL] != -1) rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MODEL], matModel);
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(matModelView, rlGetMatrixProjection()));
+    
+    if (shader.locs[SHADER_LOC_VERTEX_COLOR] != -1) {
+        float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        rlSetVertexAttributeDefault(shader.locs[SHADER_LOC_VERTEX_COLOR], white, SHADER_ATTRIB_VEC4, 4);
+    }
+}
+
+// rm_BeginShader with the surface material, plus its texture bound to the diffuse map
+static void rm_BeginMeshShader(const RM_Surface *surface, Shader shader, Matrix model)
+{
+    rm_BeginShader(shader, surface->material.maps[MATERIAL_MAP_DIFFUSE].color, model);
+    
+    int slot = 0;
+    rlActiveTextureSlot(slot);
+    rlEnableTexture(surface->material.maps[MATERIAL_MAP_DIFFUSE].texture.id);
+    rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &slot, SHADER_UNIFORM_INT, 1);
+}
+
+static void rm_EndMeshShader(void)
+{
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlActiveTextureSlot(0);
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+// Blended surface whose CPU mesh is drawn with the blend shader
+static inline bool rm_UsesBlendShader(const RM_Surface *surface)
+{
+    return surface->blendGamma > 0.0f && rm_blendShader.refCount > 0;
+}
+
+// Draw an interleaved mesh with the surface material (the blend shader when blended)
+static void rm_DrawCompactMesh(const RM_Surface *surface)
+{
+    const rm_CompactMesh *c = &surface->compact;
+    
+    // 16-bit positions are stored relative to the mesh bounds
+    Matrix model = MatrixIdentity();
+    Rectangle bounds = { 0.0f, 0.0f, 1.0f, 1.0f };
+    if (c->format == RM_VERTEX_COMPACT16) {
+        model = MatrixMultiply(MatrixScale(c->bounds.width, c->bounds.height, 1.0f),
+                               MatrixTranslate(c->bounds.x, c->bounds.y, 0.0f));
+        bounds = c->bounds;
+    }
+    
+    if (rm_UsesBlendShader(surface)) {
+        rm_BeginMeshShader(surface, rm_blendShader.shader, model);
+        rm_SetBlendUniforms(surface, &rm_blendShader.locs, bounds);
+    } else {
+        rm_BeginMeshShader(surface, surface->material.shader, model);
+    }
+    
+    // Row bands: one draw call per band (rlgl only draws 16-bit indices)
+    for (int i = 0; i < c->bandCount; i++) {
+        const rm_MeshBand *band = &c->bands[i];
+        if (!rlEnableVertexArray(band->vaoId)) {
+            rlEnableVertexBuffer(c->vboId);
+            rm_SetVertexLayout(c->format, band->firstVertex * c->stride);
+            rlEnableVertexBufferElement(band->indexBuffer->eboId);
+        }
+        rlDrawVertexArrayElements(0, band->indexBuffer->indexCount, 0);
+    }
+    
+    // Without VAO support the layout is bound on every draw
+    if (c->bandCount == 0) {
+        if (!rlEnableVertexArray(c->vaoId)) {
+            rlEnableVertexBuffer(c->vboId);
+            rm_SetVertexLayout(c->format, 0);
+            rlEnableVertexBufferElement(c->eboId);
+        }
+        rlDrawVertexArrayElements(0, c->indexCount, 0);
+    }
+    
+    rm_EndMeshShader();
+}
+
+// Draw the shared unit grid, warped by the vertex shader with the surface transform
+static void rm_DrawWarpGrid(const RM_Surface *surface)
+{
+    const rm_IndexBuffer *grid = surface->indexBuffer;
+    const rm_Transform *t = &surface->transform;
+    
+    rm_BeginMeshShader(surface, rm_warpShader.shader, MatrixIdentity());
+    
+    // The whole per-frame cost of a quad change: 18 floats of uniforms
+    int mode = (t->mode == RM_MAP_HOMOGRAPHY) ? 1 : 0;
+    rlSetUniform(rm_warpShader.modeLoc, &mode, SHADER_UNIFORM_INT, 1);
+    
+    // Texture region: offset of (u, 1 - v) = (0, 0) and extent of (1, 1)
+    Vector2 origin = rm_SurfaceTexcoord(surface, 0.0f, 1.0f);
+    Vector2 extent = rm_SurfaceTexcoord(surface, 1.0f, 0.0f);
+    float texRect[4] = { origin.x, origin.y, extent.x - origin.x, extent.y - origin.y };
+    rlSetUniform(rm_warpShader.texRectLoc, texRect, SHADER_UNIFORM_VEC4, 1);
+    rm_SetBlendUniforms(surface, &rm_warpShader.blend, (Rectangle){ 0.0f, 0.0f, 1.0f, 1.0f });
+    if (mode == 1) {
+        rlSetUniform(rm_warpShader.homographyLoc, &t->homography.m[0][0], SHADER_UNIFORM_VEC3, 3);
+    } else {
+        rlSetUniform(rm_warpShader.cornersLoc, &t->quad, SHADER_UNIFORM_VEC2, 4);
+    }
+    
+    if (!rlEnableVertexArray(grid->gridVaoId)) {
+        rlEnableVertexBuffer(grid->gridVboId);
+        rlSetVertexAttribute(RM_ATTRIB_POSITION, 2, RL_FLOAT, false, 0, RM_ATTRIB_OFFSET(0));
+        rlEnableVertexAttribute(RM_ATTRIB_POSITION);
+        rlEnableVertexBufferElement(grid->eboId);
+    }
+    
+    rlDrawVertexArrayElements(0, grid->indexCount, 0);
+    
+    rm_EndMeshShader();
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Worker Threads
+//--------------------------------------------------------------------------------------------
+
+// Jobs are claimed by index, from any thread
+typedef struct {
+    void (*run)(void *jobs, long index);
+    void *jobs;
+    long count;
+    long next;                      // Next unclaimed job (atomic)
+} rm_JobQueue;
+
+// Claim and run jobs until the queue is empty
+static void rm_DrainJobQueue(rm_JobQueue *queue)
+{
+#if defined(RM_THREADS)
+    for (long i = RM_ATOMIC_FETCH_ADD(&queue->next, 1); i < queue->count; i = RM_ATOMIC_FETCH_ADD(&queue->next, 1)) {
+        queue->run(queue->jobs, i);
+    }
+#else
+    for (; queue->next < queue->count; queue->next++) {
+        queue->run(queue->jobs, queue->next);
+    }
+#endif
+}
+
+#if defined(RM_THREADS)
+#if defined(_WIN32)
+typedef uintptr_t rm_Thread;
+
+static unsigned __stdcall rm_Worker(void *arg)
+{
+    rm_DrainJobQueue((rm_JobQueue *)arg);
+    return 0;
+}
+
+static bool rm_StartThread(rm_Thread *thread, rm_JobQueue *queue)
+{
+    *thread = _beginthreadex(NULL, 0, rm_Worker, queue, 0, NULL);
+    return (*thread != 0);
+}
+
+static void rm_JoinThread(rm_Thread thread)
+{
+    WaitForSingleObject((void *)thread, 0xFFFFFFFF);
+    CloseHandle((void *)thread);
+}
+#else
+typedef pthread_t rm_Thread;
+
+static void *rm_Worker(void *arg)
+{
+    rm_DrainJobQueue((rm_JobQueue *)arg);
+    return NULL;
+}
+
+static bool rm_StartThread(rm_Thread *thread, rm_JobQueue *queue)
+{
+    return (pthread_create(thread, NULL, rm_Worker, queue) == 0);
+}
+
+static void rm_JoinThread(rm_Thread thread)
+{
+    pthread_join(thread, NULL);
+}
+#endif
+#endif
+
+// Run run(jobs, i) for every job, on RAYMAP_WORKER_THREADS threads plus the calling one.
+// Threads only live for the call: their start cost is small next to the work worth splitting
+static void rm_RunJobs(void (*run)(void *jobs, long index), void *jobs, int count)
+{
+    rm_JobQueue queue = { run, jobs, count, 0 };
+    
+#if defined(RM_THREADS)
+    rm_Thread threads[RAYMAP_WORKER_THREADS > 0 ? RAYMAP_WORKER_THREADS : 1];
+    int threadCount = 0;
+    
+    while (threadCount < RAYMAP_WORKER_THREADS && threadCount < count - 1) {
+        if (!rm_StartThread(&threads[threadCount], &queue)) {
+            TraceLog(LOG_WARNING, "RAYMAP: Failed to start worker thread, using %d", threadCount);
+            break;
+        }
+        threadCount++;
+    }
+    
+    rm_DrainJobQueue(&queue);
+    for (int i = 0; i < threadCount; i++) rm_JoinThread(threads[i]);
+#else
+    rm_DrainJobQueue(&queue);
+#endif
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Parallel Mesh Update
+//--------------------------------------------------------------------------------------------
+
+// One surface of RM_UpdateSurfaces: positions rewritten in place, or a new mesh prepared
+typedef struct {
+    RM_Surface *surface;
+    int cols;
+    int rows;
+    bool inPlace;                   // Same grid and layout, rewrite the CPU copy only
+    rm_MeshBuild build;             // New mesh (rebuild jobs)
+} rm_MeshJob;
+
+// CPU part of one job, safe to run concurrently with other surfaces' jobs
+static void rm_RunMeshJob(void *jobs, long index)
+{
+    rm_MeshJob *job = &((rm_MeshJob *)jobs)[index];
+    if (job->inPlace) {
+        rm_RewriteMeshPositions(job->surface, job->cols, job->rows);
+    } else {
+        rm_PrepareMesh(job->surface, job->cols, job->rows, &job->build);
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Content Regions
+//--------------------------------------------------------------------------------------------
+
+// Grow a rectangle to whole pixels and clip it to the surface (empty rectangles have zero size)
+static Rectangle rm_ClipSurfaceRegion(const RM_Surface *surface, Rectangle r)
+{
+    float x0 = floorf(fmaxf(r.x, 0.0f));
+    float y0 = floorf(fmaxf(r.y, 0.0f));
+    float x1 = ceilf(fminf(r.x + r.width, (float)surface->width));
+    float y1 = ceilf(fminf(r.y + r.height, (float)surface->height));
+
+    if (r.width <= 0.0f || r.height <= 0.0f || x1 <= x0 || y1 <= y0) return (Rectangle){ 0 };
+    return (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Bounding rectangle of two regions, ignoring empty ones
+static Rectangle rm_RegionUnion(Rectangle a, Rectangle b)
+{
+    if (a.width <= 0.0f || a.height <= 0.0f) return b;
+    if (b.width <= 0.0f || b.height <= 0.0f) return a;
+
+    float x0 = fminf(a.x, b.x);
+    float y0 = fminf(a.y, b.y);
+    float x1 = fmaxf(a.x + a.width, b.x + b.width);
+    float y1 = fmaxf(a.y + a.height, b.y + b.height);
+    return (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Bind the surface target with viewport, projection and scissor limited to a pixel aligned
+// region (surface pixels, y down). Drawing coordinates stay the surface ones
+static void rm_BeginSurfaceArea(RM_Surface *surface, Rectangle area)
+{
+    BeginTextureMode(surface->target);
+
+    // Framebuffer rectangle (y up), inside the atlas region for atlas surfaces
+    Rectangle origin = surface->atlasPage ? surface->atlasRect :
+                       (Rectangle){ 0.0f, 0.0f, (float)surface->width, (float)surface->height };
+    int x = (int)(origin.x + area.x);
+    int y = (int)(origin.y + origin.height - area.y - area.height);
+    int w = (int)area.width;
+    int h = (int)area.height;
+
+    if (w > 0 && h > 0) {
+        rlViewport(x, y, w, h);
+        rlMatrixMode(RL_PROJECTION);
+        rlLoadIdentity();
+        rlOrtho(area.x, area.x + area.width, area.y + area.height, area.y, 0.0f, 1.0f);
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+    }
+    rlEnableScissorTest();
+    rlScissor(x, y, w, h);
+    surface->scissorPass = true;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Visibility
+//--------------------------------------------------------------------------------------------
+
+// Output viewports set by RM_SetOutputViewports (none: every surface is visible)
+static Rectangle rm_outputViewports[RM_MAX_OUTPUT_VIEWPORTS];
+static int rm_outputViewportCount = 0;
+
+// Screen area a surface covers: the quad bounds, or the spline bounds in grid mode
+static Rectangle rm_GetSurfaceBounds(const RM_Surface *surface)
+{
+    return (surface->mode == RM_MAP_GRID) ? surface->grid.bounds : RM_GetQuadBounds(surface->quad);
+}
+
+// Surface bounds against the output viewports. Degenerate quads are never visible
+static bool rm_IsSurfaceVisible(const RM_Surface *surface)
+{
+    if (fabsf(RM_GetQuadArea(surface->quad)) <= RM_EPSILON) return false;
+    if (rm_outputViewportCount == 0) return true;
+    
+    Rectangle b = rm_GetSurfaceBounds(surface);
+    for (int i = 0; i < rm_outputViewportCount; i++) {
+        Rectangle v = rm_outputViewports[i];
+        if (b.x < v.x + v.width && b.x + b.width > v.x &&
+            b.y < v.y + v.height && b.y + b.height > v.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Output Layout
+//--------------------------------------------------------------------------------------------
+
+// Surface of a layout and the output it is drawn on
+typedef struct {
+    RM_Surface *surface;
+    int output;                     // RM_ALL_OUTPUTS: every output it overlaps
+} rm_OutputEntry;
+
+struct RM_OutputLayout {
+    RM_Output outputs[RM_MAX_OUTPUT_VIEWPORTS];
+    int outputCount;
+    rm_OutputEntry *entries;        // In draw order
+    int entryCount;
+    int entryCapacity;
+    int lastDrawCount;
+};
+
+// Culling viewports and modelview replaced by the output between RM_BeginOutput and RM_EndOutput
+static Rectangle rm_savedViewports[RM_MAX_OUTPUT_VIEWPORTS];
+static int rm_savedViewportCount = 0;
+static Matrix rm_savedModelview;
+static bool rm_outputActive = false;
+
+static bool rm_IsOutputValid(RM_Output output)
+{
+    if (output.width <= 0 || output.height <= 0) {
+        TraceLog(LOG_WARNING, "RAYMAP: Invalid output size %dx%d", output.width, output.height);
+        return false;
+    }
+    if (output.source.width < 0.0f || output.source.height < 0.0f ||
+        (output.source.width == 0.0f) != (output.source.height == 0.0f)) {
+        TraceLog(LOG_WARNING, "RAYMAP: Invalid output source %.0fx%.0f", output.source.width, output.source.height);
+        return false;
+    }
+    if (output.rotation != 0 && output.rotation != 90 && output.rotation != 180 && output.rotation != 270) {
+        TraceLog(LOG_WARNING, "RAYMAP: Invalid output rotation %d (must be 0, 90, 180 or 270)", output.rotation);
+        return false;
+    }
+    return true;
+}
+
+// Window region of an output: width and height swap when it is rotated a quarter turn
+static void rm_GetOutputRegion(RM_Output output, int *width, int *height)
+{
+    bool quarter = (output.rotation == 90 || output.rotation == 270);
+    *width = quarter ? output.height : output.width;
+    *height = quarter ? output.width : output.height;
+}
+
+// Quad space area shown by an output
+static Rectangle rm_GetOutputSource(RM_Output output)
+{
+    if (output.source.width > 0.0f) return output.source;
+    return (Rectangle){ (float)output.x, (float)output.y, (float)output.width, (float)output.height };
+}
+
+// Output pixel to region pixel (both y down), rotated clockwise about the region
+static Vector2 rm_RotateToRegion(RM_Output output, Vector2 p)
+{
+    float w = (float)output.width;
+    float h = (float)output.height;
+    switch (output.rotation) {
+        case 90: return (Vector2){ h - p.y, p.x };
+        case 180: return (Vector2){ w - p.x, h - p.y };
+        case 270: return (Vector2){ p.y, w - p.x };
+        default: return p;
+    }
+}
+
+// Inverse of rm_RotateToRegion
+static Vector2 rm_RotateFromRegion(RM_Output output, Vector2 r)
+{
+    float w = (float)output.width;
+    float h = (float)output.height;
+    switch (output.rotation) {
+        case 90: return (Vector2){ r.y, h - r.x };
+        case 180: return (Vector2){ w - r.x, h - r.y };
+        case 270: return (Vector2){ w - r.y, r.x };
+        default: return r;
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Surface Batch
+//--------------------------------------------------------------------------------------------
+
+// Batch vertex: screen position, projective texcoords (s, t, q) and the texture slot (layer).
+// Projective texcoords keep homography surfaces exact on any grid, down to a single cell
+#define RM_BATCH_VERTEX_FLOATS 6
+
+// Batch shader: the texture of each vertex is picked by its layer. Samplers are indexed with
+// constants only (GLSL 330 and 100 both require it)
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    #define RM_GLSL_BATCH_VERTEX_HEADER   "#version 100\nattribute vec2 vertexPosition;\nattribute vec4 vertexTexCoord;\n" \
+                                          "varying vec3 fragTexCoord;\nvarying float fragLayer;\n"
+    #define RM_GLSL_BATCH_FRAGMENT_HEADER "#version 100\n#ifdef GL_FRAGMENT_PRECISION_HIGH\nprecision highp float;\n#else\nprecision mediump float;\n#endif\n" \
+                                          "varying vec3 fragTexCoord;\nvarying float fragLayer;\n#define finalColor gl_FragColor\n#define texture texture2D\n"
+#else
+    #define RM_GLSL_BATCH_VERTEX_HEADER   "#version 330\nin vec2 vertexPosition;\nin vec4 vertexTexCoord;\n" \
+                                          "out vec3 fragTexCoord;\nout float fragLayer;\n"
+    #define RM_GLSL_BATCH_FRAGMENT_HEADER "#version 330\nin vec3 fragTexCoord;\nin float fragLayer;\nout vec4 finalColor;\n"
+#endif
+
+static const char *rm_batchVertexShader = RM_GLSL_BATCH_VERTEX_HEADER
+    "uniform mat4 mvp;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord.xyz;\n"
+    "    fragLayer = vertexTexCoord.w;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *rm_batchFragmentShader = RM_GLSL_BATCH_FRAGMENT_HEADER
+    "uniform sampler2D batchTextures[8];\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 uv = fragTexCoord.xy/fragTexCoord.z;\n"
+    "    vec4 color;\n"
+    "    if (fragLayer < 0.5) color = texture(batchTextures[0], uv);\n"
+    "    else if (fragLayer < 1.5) color = texture(batchTextures[1], uv);\n"
+    "    else if (fragLayer < 2.5) color = texture(batchTextures[2], uv);\n"
+    "    else if (fragLayer < 3.5) color = texture(batchTextures[3], uv);\n"
+    "    else if (fragLayer < 4.5) color = texture(batchTextures[4], uv);\n"
+    "    else if (fragLayer < 5.5) color = texture(batchTextures[5], uv);\n"
+    "    else if (fragLayer < 6.5) color = texture(batchTextures[6], uv);\n"
+    "    else color = texture(batchTextures[7], uv);\n"
+    "    finalColor = color*colDiffuse;\n"
+    "}\n";
+
+// Batch shader shared by all batches, loaded with the first one
+typedef struct {
+    Shader shader;
+    int texturesLoc;
+    int refCount;
+} rm_BatchShader;
+
+static rm_BatchShader rm_batchShader = { 0 };
+
+// Surface of a batch and the vertices it owns in the batch buffer
+typedef struct {
+    RM_Surface *surface;
+    int firstVertex;
+    int cols, rows;                 // Grid the vertices were built with
+    unsigned int transformSeq;      // Transform the vertices were built from
+    int draw;                       // Draw call the surface is in
+    int layer;                      // Texture slot of the surface in its draw call
+} rm_BatchEntry;
+
+// Consecutive entries drawn with one call: at most 65535 vertices and RM_BATCH_MAX_TEXTURES
+// distinct textures (atlas surfaces on the same page share one)
+typedef struct {
+    int firstIndex;
+    int indexCount;
+    int firstVertex;
+    unsigned int vaoId;
+    unsigned int textures[RM_BATCH_MAX_TEXTURES];
+    int textureCount;
+    bool visible;                   // At least one of its surfaces is visible
+} rm_BatchDraw;
+
+struct RM_SurfaceBatch {
+    rm_BatchEntry *entries;
+    int entryCount;
+    int entryCapacity;
+    rm_BatchDraw *draws;
+    int drawCount;
+    float *vertices;                // CPU copy of the vertex buffer
+    int vertexCount;
+    unsigned int vboId;
+    unsigned int eboId;
+    bool layoutDirty;               // Surfaces or grids changed: rebuild buffers on next draw
+    int lastDrawCalls;
+};
+
+// Texture slots never change: sampler i reads unit i
+static void rm_SetupBatchShader(Shader shader)
+{
+    int slots[RM_BATCH_MAX_TEXTURES];
+    for (int i = 0; i < RM_BATCH_MAX_TEXTURES; i++) slots[i] = i;
+    rm_batchShader.texturesLoc = GetShaderLocation(shader, "batchTextures");
+    rlEnableShader(shader.id);
+    rlSetUniform(rm_batchShader.texturesLoc, slots, SHADER_UNIFORM_INT, RM_BATCH_MAX_TEXTURES);
+    rlDisableShader();
+}
+
+static bool rm_AcquireBatchShader(void)
+{
+    return rm_AcquireSharedShader(&rm_batchShader.shader, &rm_batchShader.refCount,
+                                  rm_batchVertexShader, rm_batchFragmentShader, "batch", rm_SetupBatchShader);
+}
+
+static void rm_ReleaseBatchShader(void)
+{
+    rm_ReleaseSharedShader(&rm_batchShader.shader, &rm_batchShader.refCount, "batch");
+}
+
+// Grid a surface is batched with. Batch texcoords are projective, so a homography is exact
+// on a single cell like with GPU warp; bilinear surfaces keep their grid, within one draw call
+static void rm_GetBatchResolution(const RM_Surface *surface, int *cols, int *rows)
+{
+    if (surface->mode == RM_MAP_HOMOGRAPHY) {
+        *cols = 1;
+        *rows = 1;
+        return;
+    }
+    *cols = surface->meshColumns;
+    *rows = surface->meshRows;
+    rm_FitIndexRange(cols, rows);
+}
+
+// Write the vertices of one batched surface
+static void rm_WriteBatchVertices(const rm_BatchEntry *entry, float *vertices, float layer)
+{
+    const RM_Surface *surface = entry->surface;
+    const Matrix3x3 *h = &surface->transform.homography;
+    int cols = entry->cols;
+    int rows = entry->rows;
+    
+    rm_ComputeMeshPositions(surface, vertices, RM_BATCH_VERTEX_FLOATS, cols, rows);
+    
+    for (int y = 0, i = 0; y <= rows; y++) {
+        for (int x = 0; x <= cols; x++, i++) {
+            float u = (float)x / (float)cols;
+            float v = (float)y / (float)rows;
+            float w = 1.0f;
+            if (surface->mode == RM_MAP_HOMOGRAPHY) {
+                float hw = h->m[2][0] * u + h->m[2][1] * v + h->m[2][2];
+                if (fabsf(hw) > RM_EPSILON) w = hw;
+            }
+            
+            Vector2 uv = rm_SurfaceTexcoord(surface, u, v);
+            float *vertex = &vertices[i * RM_BATCH_VERTEX_FLOATS];
+            vertex[2] = uv.x / w;
+            vertex[3] = uv.y / w;
+            vertex[4] = 1.0f / w;
+            vertex[5] = layer;
+        }
+    }
+}
+
+static void rm_UnloadBatchBuffers(RM_SurfaceBatch *batch)
+{
+    for (int i = 0; i < batch->drawCount; i++) {
+        if (batch->draws[i].vaoId > 0) rlUnloadVertexArray(batch->draws[i].vaoId);
+    }
+    if (batch->vboId > 0) rlUnloadVertexBuffer(batch->vboId);
+    if (batch->eboId > 0) rlUnloadVertexBuffer(batch->eboId);
+    if (batch->draws) RMFREE(batch->draws);
+    if (batch->vertices) RMFREE(batch->vertices);
+    
+    batch->draws = NULL;
+    batch->drawCount = 0;
+    batch->vertices = NULL;
+    batch->vertexCount = 0;
+    batch->vboId = 0;
+    batch->eboId = 0;
+}
+
+// Attribute layout of the batch vertex buffer, starting offset bytes in (one draw call)
+static void rm_SetBatchLayout(int offset)
+{
+    int stride = RM_BATCH_VERTEX_FLOATS * (int)sizeof(float);
+    rlSetVertexAttribute(RM_ATTRIB_POSITION, 2, RL_FLOAT, false, stride, RM_ATTRIB_OFFSET(offset));
+    rlEnableVertexAttribute(RM_ATTRIB_POSITION);
+    rlSetVertexAttribute(RM_ATTRIB_TEXCOORD, 4, RL_FLOAT, false, stride, RM_ATTRIB_OFFSET(offset + 2 * sizeof(float)));
+    rlEnableVertexAttribute(RM_ATTRIB_TEXCOORD);
+}
+
+// Lay out every surface in the batch buffers and split them into draw calls
+static bool rm_BuildBatch(RM_SurfaceBatch *batch)
+{
+    rm_UnloadBatchBuffers(batch);
+    batch->layoutDirty = false;
+    if (batch->entryCount == 0) return true;
+    
+    batch->draws = (rm_BatchDraw *)RMCALLOC(batch->entryCount, sizeof(rm_BatchDraw));
+    if (!batch->draws) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate surface batch draws");
+        return false;
+    }
+    
+    // Assign vertices, draw call and texture slot of every surface
+    int vertexCount = 0;
+    int indexCount = 0;
+    rm_BatchDraw *draw = NULL;
+    for (int i = 0; i < batch->entryCount; i++) {
+        rm_BatchEntry *entry = &batch->entries[i];
+        rm_GetBatchResolution(entry->surface, &entry->cols, &entry->rows);
+        
+        int count = (entry->cols + 1) * (entry->rows + 1);
+        unsigned int texture = entry->surface->target.texture.id;
+        int layer = -1;
+        for (int k = 0; draw && k < draw->textureCount; k++) {
+            if (draw->textures[k] == texture) layer = k;
+        }
+        
+        if (!draw || (layer < 0 && draw->textureCount == RM_BATCH_MAX_TEXTURES) ||
+            vertexCount + count - draw->firstVertex > UINT16_MAX) {
+            draw = draw ? draw + 1 : batch->draws;
+            draw->firstIndex = indexCount;
+            draw->firstVertex = vertexCount;
+            layer = -1;
+        }
+        if (layer < 0) {
+            layer = draw->textureCount;
+            draw->textures[draw->textureCount++] = texture;
+        }
+        
+        entry->firstVertex = vertexCount;
+        entry->draw = (int)(draw - batch->draws);
+        entry->layer = layer;
+        vertexCount += count;
+        indexCount += entry->cols * entry->rows * 6;
+        draw->indexCount += entry->cols * entry->rows * 6;
+    }
+    batch->drawCount = (int)(draw - batch->draws) + 1;
+    
+    batch->vertices = (float *)RMMALLOC((size_t)vertexCount * RM_BATCH_VERTEX_FLOATS * sizeof(float));
+    unsigned short *indices = (unsigned short *)RMMALLOC((size_t)indexCount * sizeof(unsigned short));
+    if (!batch->vertices || !indices) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate surface batch [%d vertices]", vertexCount);
+        if (indices) RMFREE(indices);
+        rm_UnloadBatchBuffers(batch);
+        return false;
+    }
+    batch->vertexCount = vertexCount;
+    
+    // Vertices and indices relative to the first vertex of each draw call
+    int index = 0;
+    for (int i = 0; i < batch->entryCount; i++) {
+        rm_BatchEntry *entry = &batch->entries[i];
+        rm_WriteBatchVertices(entry, &batch->vertices[entry->firstVertex * RM_BATCH_VERTEX_FLOATS], (float)entry->layer);
+        entry->transformSeq = entry->surface->transformSeq;
+        
+        unsigned short base = (unsigned short)(entry->firstVertex - batch->draws[entry->draw].firstVertex);
+        int entryIndices = entry->cols * entry->rows * 6;
+        rm_GenerateGridIndices(&indices[index], entry->cols, entry->rows);
+        for (int k = 0; k < entryIndices; k++) indices[index + k] += base;
+        index += entryIndices;
+    }
+    
+    // Upload: one buffer pair, one vertex array per draw call
+    rlDisableVertexArray();
+    batch->vboId = rlLoadVertexBuffer(batch->vertices, vertexCount * RM_BATCH_VERTEX_FLOATS * (int)sizeof(float), true);
+    batch->eboId = rlLoadVertexBufferElement(indices, indexCount * (int)sizeof(unsigned short), false);
+    RMFREE(indices);
+    
+    if (batch->vboId == 0 || batch->eboId == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to upload surface batch to GPU");
+        rm_UnloadBatchBuffers(batch);
+        return false;
+    }
+    
+    for (int i = 0; i < batch->drawCount; i++) {
+        rm_BatchDraw *d = &batch->draws[i];
+        d->vaoId = rlLoadVertexArray();
+        rlEnableVertexArray(d->vaoId);
+        rlEnableVertexBuffer(batch->vboId);
+        rm_SetBatchLayout(d->firstVertex * RM_BATCH_VERTEX_FLOATS * (int)sizeof(float));
+        rlEnableVertexBufferElement(batch->eboId);
+        rlDisableVertexArray();
+    }
+    
+    TraceLog(LOG_DEBUG, "RAYMAP: Surface batch built [%d surfaces, %d vertices, %d draw calls]",
+             batch->entryCount, vertexCount, batch->drawCount);
+    return true;
+}
+
+// Rewrite the vertices of surfaces whose quad changed, one upload for the changed range
+static void rm_UpdateBatchVertices(RM_SurfaceBatch *batch)
+{
+    int first = batch->vertexCount;
+    int last = 0;
+    
+    for (int i = 0; i < batch->entryCount; i++) {
+        rm_BatchEntry *e = &batch->entries[i];
+        if (e->transformSeq == e->surface->transformSeq) continue;
+        
+        rm_WriteBatchVertices(e, &batch->vertices[e->firstVertex * RM_BATCH_VERTEX_FLOATS], (float)e->layer);
+        e->transformSeq = e->surface->transformSeq;
+        
+        int count = (e->cols + 1) * (e->rows + 1);
+        if (e->firstVertex < first) first = e->firstVertex;
+        if (e->firstVertex + count > last) last = e->firstVertex + count;
+    }
+    
+    if (last > first) {
+        int stride = RM_BATCH_VERTEX_FLOATS * (int)sizeof(float);
+        rlUpdateVertexBuffer(batch->vboId, &batch->vertices[first * RM_BATCH_VERTEX_FLOATS],
+                             (last - first) * stride, first * stride);
+    }
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Warp Map
+//--------------------------------------------------------------------------------------------
+
+// Composite shader: every output pixel reads its table texel, then the surface texture it names.
+// Samplers are indexed with constants only, like the batch shader
+#if defined(GRAPHICS_API_OPENGL_ES2)
+    #define RM_GLSL_WARP_MAP_VERTEX_HEADER   "#version 100\nattribute vec2 vertexPosition;\nattribute vec2 vertexTexCoord;\n" \
+                                             "varying vec2 fragTexCoord;\n"
+    #define RM_GLSL_WARP_MAP_FRAGMENT_HEADER "#version 100\n#ifdef GL_FRAGMENT_PRECISION_HIGH\nprecision highp float;\n#else\nprecision mediump float;\n#endif\n" \
+                                             "varying vec2 fragTexCoord;\n#define finalColor gl_FragColor\n#define texture texture2D\n"
+#else
+    #define RM_GLSL_WARP_MAP_VERTEX_HEADER   "#version 330\nin vec2 vertexPosition;\nin vec2 vertexTexCoord;\nout vec2 fragTexCoord;\n"
+    #define RM_GLSL_WARP_MAP_FRAGMENT_HEADER "#version 330\nin vec2 fragTexCoord;\nout vec4 finalColor;\n"
+#endif
+
+static const char *rm_warpMapVertexShader = RM_GLSL_WARP_MAP_VERTEX_HEADER
+    "uniform mat4 mvp;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    gl_Position = mvp*vec4(vertexPosition, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *rm_warpMapFragmentShader = RM_GLSL_WARP_MAP_FRAGMENT_HEADER
+    "uniform sampler2D warpTable;\n"
+    "uniform sampler2D warpTextures[7];\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    vec3 entry = texture(warpTable, fragTexCoord).xyz;\n"
+    "    if (entry.z < 0.5) discard;\n"
+    "    vec4 color;\n"
+    "    if (entry.z < 1.5) color = texture(warpTextures[0], entry.xy);\n"
+    "    else if (entry.z < 2.5) color = texture(warpTextures[1], entry.xy);\n"
+    "    else if (entry.z < 3.5) color = texture(warpTextures[2], entry.xy);\n"
+    "    else if (entry.z < 4.5) color = texture(warpTextures[3], entry.xy);\n"
+    "    else if (entry.z < 5.5) color = texture(warpTextures[4], entry.xy);\n"
+    "    else if (entry.z < 6.5) color = texture(warpTextures[5], entry.xy);\n"
+    "    else color = texture(warpTextures[6], entry.xy);\n"
+    "    finalColor = color*colDiffuse;\n"
+    "}\n";
+
+// Composite shader shared by all warp maps, loaded with the first one
+typedef struct {
+    Shader shader;
+    int refCount;
+} rm_WarpMapShader;
+
+static rm_WarpMapShader rm_warpMapShader = { 0 };
+
+// Surface of a warp map and what its texels were baked from
+typedef struct {
+    RM_Surface *surface;
+    int layer;                      // Texture slot of the surface
+    unsigned int transformSeq;      // Transform the table was baked from
+    Rectangle bounds;               // Surface bounds at that bake (empty if degenerate)
+} rm_WarpMapEntry;
+
+struct RM_WarpMap {
+    int width;                      // Output size, one table texel per pixel
+    int height;
+    rm_WarpMapEntry *entries;       // Bottom to top
+    int entryCount;
+    int entryCapacity;
+    unsigned int textures[RM_WARP_MAP_MAX_TEXTURES];
+    int textureCount;
+    float *table;                   // CPU copy of the table, 3 floats per texel
+    unsigned int tableId;
+    unsigned int vaoId;             // Full-screen quad (0 without VAO support)
+    unsigned int vboId;
+    bool layoutDirty;               // Surfaces added or removed: rebake the whole table
+    int bakes;
+};
+
+// Rows [y0, y1) of the table baked by one worker
+typedef struct {
+    RM_WarpMap *map;
+    int y0, y1;
+} rm_WarpBakeJob;
+
+// Texture slots never change: the table reads unit 0, surface texture i unit i + 1
+static void rm_SetupWarpMapShader(Shader shader)
+{
+    int tableSlot = 0;
+    int slots[RM_WARP_MAP_MAX_TEXTURES];
+    for (int i = 0; i < RM_WARP_MAP_MAX_TEXTURES; i++) slots[i] = i + 1;
+    rlEnableShader(shader.id);
+    rlSetUniform(GetShaderLocation(shader, "warpTable"), &tableSlot, SHADER_UNIFORM_INT, 1);
+    rlSetUniform(GetShaderLocation(shader, "warpTextures"), slots, SHADER_UNIFORM_INT, RM_WARP_MAP_MAX_TEXTURES);
+    rlDisableShader();
+}
+
+static bool rm_AcquireWarpMapShader(void)
+{
+    return rm_AcquireSharedShader(&rm_warpMapShader.shader, &rm_warpMapShader.refCount,
+                                  rm_warpMapVertexShader, rm_warpMapFragmentShader, "warp map", rm_SetupWarpMapShader);
+}
+
+static void rm_ReleaseWarpMapShader(void)
+{
+    rm_ReleaseSharedShader(&rm_warpMapShader.shader, &rm_warpMapShader.refCount, "warp map");
+}
+
+// Texture slot of a texture in the warp map (-1 if not sampled yet)
+static int rm_FindWarpMapTexture(const RM_WarpMap *map, unsigned int texture)
+{
+    for (int i = 0; i < map->textureCount; i++) {
+        if (map->textures[i] == texture) return i;
+    }
+    return -1;
+}
+
+// Full-screen quad layout: screen position and table texcoord
+static void rm_SetWarpMapLayout(void)
+{
+    int stride = 4 * (int)sizeof(float);
+    rlSetVertexAttribute(RM_ATTRIB_POSITION, 2, RL_FLOAT, false, stride, RM_ATTRIB_OFFSET(0));
+    rlEnableVertexAttribute(RM_ATTRIB_POSITION);
+    rlSetVertexAttribute(RM_ATTRIB_TEXCOORD, 2, RL_FLOAT, false, stride, RM_ATTRIB_OFFSET(2 * sizeof(float)));
+    rlEnableVertexAttribute(RM_ATTRIB_TEXCOORD);
+}
+
+// Table pixels a surface can cover, clamped to the map (empty if the quad is degenerate)
+static Rectangle rm_GetWarpBounds(const RM_WarpMap *map, const RM_Surface *surface)
+{
+    if (fabsf(RM_GetQuadArea(surface->quad)) <= RM_EPSILON) return (Rectangle){ 0 };
+    
+    Rectangle b = rm_GetSurfaceBounds(surface);
+    float x0 = fmaxf(floorf(b.x), 0.0f);
+    float y0 = fmaxf(floorf(b.y), 0.0f);
+    float x1 = fminf(ceilf(b.x + b.width), (float)map->width);
+    float y1 = fminf(ceilf(b.y + b.height), (float)map->height);
+    if (x1 <= x0 || y1 <= y0) return (Rectangle){ 0 };
+    return (Rectangle){ x0, y0, x1 - x0, y1 - y0 };
+}
+
+// Bake one band of rows: every pixel center is unmapped through each surface covering it,
+// bottom to top, so the top surface wins. Uses the batch unmapping kernels
+static void rm_RunWarpBakeJob(void *jobs, long index)
+{
+    const rm_WarpBakeJob *job = &((const rm_WarpBakeJob *)jobs)[index];
+    RM_WarpMap *map = job->map;
+    int width = map->width;
+    
+    float *band = &map->table[(size_t)job->y0 * width * 3];
+    memset(band, 0, (size_t)(job->y1 - job->y0) * width * 3 * sizeof(float));
+    
+    Vector2 *points = (Vector2 *)RMMALLOC((size_t)width * 2 * sizeof(Vector2));
+    if (!points) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate warp map bake buffer");
+        return;
+    }
+    Vector2 *uv = points + width;
+    
+    for (int i = 0; i < map->entryCount; i++) {
+        const rm_WarpMapEntry *e = &map->entries[i];
+        Rectangle b = e->bounds;
+        int x0 = (int)b.x;
+        int count = (int)b.width;
+        int y0 = ((int)b.y > job->y0) ? (int)b.y : job->y0;
+        int y1 = ((int)(b.y + b.height) < job->y1) ? (int)(b.y + b.height) : job->y1;
+        float layer = (float)(e->layer + 1);
+        
+        for (int y = y0; y < y1; y++) {
+            for (int x = 0; x < count; x++) points[x] = (Vector2){ (float)(x0 + x) + 0.5f, (float)y + 0.5f };
+            RM_UnmapPoints(e->surface, points, uv, count);
+            
+            float *texel = &map->table[((size_t)y * width + x0) * 3];
+            for (int x = 0; x < count; x++, texel += 3) {
+                if (uv[x].x < 0.0f) continue;
+                Vector2 st = rm_SurfaceTexcoord(e->surface, uv[x].x, uv[x].y);
+                texel[0] = st.x;
+                texel[1] = st.y;
+                texel[2] = layer;
+            }
+        }
+    }
+    
+    RMFREE(points);
+}
+
+// Grow [top, bottom) to the rows of a rectangle (empty rectangles are ignored)
+static void rm_AddWarpRows(Rectangle r, int *top, int *bottom)
+{
+    if (r.width <= 0.0f || r.height <= 0.0f) return;
+    if ((int)r.y < *top) *top = (int)r.y;
+    if ((int)(r.y + r.height) > *bottom) *bottom = (int)(r.y + r.height);
+}
+
+// Rebake the rows covered by moved surfaces, before and after the move (all rows after a
+// layout change), in parallel bands, then upload them in one texture update
+static void rm_BakeWarpMap(RM_WarpMap *map)
+{
+    int top = map->height;
+    int bottom = 0;
+    if (map->layoutDirty) {
+        top = 0;
+        bottom = map->height;
+    }
+    
+    for (int i = 0; i < map->entryCount; i++) {
+        rm_WarpMapEntry *e = &map->entries[i];
+        if (!map->layoutDirty && e->transformSeq == e->surface->transformSeq) continue;
+        
+        rm_AddWarpRows(e->bounds, &top, &bottom);
+        e->bounds = rm_GetWarpBounds(map, e->surface);
+        e->transformSeq = e->surface->transformSeq;
+        rm_AddWarpRows(e->bounds, &top, &bottom);
+    }
+    map->layoutDirty = false;
+    if (bottom <= top) return;
+    
+    int jobCount = (bottom - top + RM_WARP_BAKE_ROWS - 1) / RM_WARP_BAKE_ROWS;
+    rm_WarpBakeJob *jobs = (rm_WarpBakeJob *)RMMALLOC(jobCount * sizeof(rm_WarpBakeJob));
+    if (!jobs) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate warp map bake jobs");
+        map->layoutDirty = true;
+        return;
+    }
+    for (int i = 0; i < jobCount; i++) {
+        int y0 = top + i * RM_WARP_BAKE_ROWS;
+        jobs[i] = (rm_WarpBakeJob){ map, y0, (y0 + RM_WARP_BAKE_ROWS < bottom) ? y0 + RM_WARP_BAKE_ROWS : bottom };
+    }
+    
+    double start = GetTime();
+    rm_RunJobs(rm_RunWarpBakeJob, jobs, jobCount);
+    RMFREE(jobs);
+    
+    rlUpdateTexture(map->tableId, 0, top, map->width, bottom - top, PIXELFORMAT_UNCOMPRESSED_R32G32B32,
+                    &map->table[(size_t)top * map->width * 3]);
+    map->bakes++;
+    TraceLog(LOG_DEBUG, "RAYMAP: Warp map baked [rows %d-%d, %.2f ms]", top, bottom, (GetTime() - start) * 1000.0);
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Composite Cache
+//--------------------------------------------------------------------------------------------
+
+// Cached surface and the state its pixels were drawn with
+typedef struct {
+    RM_Surface *surface;
+    unsigned int transformSeq;      // Quad, mode or lattice at the last redraw
+    unsigned int contentPasses;     // Content passes at the last redraw
+    int meshColumns;                // Requested mesh resolution at the last redraw
+    int meshRows;
+    bool gpuWarp;
+    float blendGamma;
+} rm_CompositeEntry;
+
+struct RM_CompositeCache {
+    int width;                      // Output size
+    int height;
+    RenderTexture2D target;         // Composite of the cached surfaces
+    rm_CompositeEntry *entries;     // Bottom to top
+    int entryCount;
+    int entryCapacity;
+    unsigned int blendGeneration;   // rm_blendGeneration at the last redraw
+    float blendWidth;               // rm_blendWidth at the last redraw
+    bool additive;                  // Surfaces add up instead of covering each other
+    bool dirty;                     // Surfaces added, removed or cache invalidated
+    int redraws;
+};
+
+// Anything that changes the pixels of a cached surface since the last redraw
+static bool rm_CompositeCacheChanged(const RM_CompositeCache *cache)
+{
+    if (cache->dirty) return true;
+    
+    bool blended = false;
+    for (int i = 0; i < cache->entryCount; i++) {
+        const rm_CompositeEntry *e = &cache->entries[i];
+        const RM_Surface *surface = e->surface;
+        
+        if (e->transformSeq != surface->transformSeq || e->contentPasses != surface->contentPasses ||
+            e->meshColumns != surface->meshColumns || e->meshRows != surface->meshRows ||
+            e->gpuWarp != surface->gpuWarp || e->blendGamma != surface->blendGamma) {
+            return true;
+        }
+        if (surface->blendGamma > 0.0f) blended = true;
+    }
+    
+    // Ramps of blended surfaces also follow the quads of the surfaces drawn outside the cache
+    return blended && (cache->blendGeneration != rm_blendGeneration || cache->blendWidth != rm_blendWidth);
+}
+
+static void rm_RedrawCompositeCache(RM_CompositeCache *cache)
+{
+    // Culling against the cache area, whatever viewports are set for the frame
+    Rectangle savedViewports[RM_MAX_OUTPUT_VIEWPORTS];
+    int savedViewportCount = rm_outputViewportCount;
+    memcpy(savedViewports, rm_outputViewports, sizeof(rm_outputViewports));
+    rm_outputViewports[0] = (Rectangle){ 0.0f, 0.0f, (float)cache->width, (float)cache->height };
+    rm_outputViewportCount = 1;
+    
+    // The cache stores premultiplied color: color blends as usual, but alpha only accumulates
+    // coverage. Blending alpha like color would square it, then the draw would apply it again
+    if (cache->additive) {
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE, RL_ONE, RL_ONE, RL_FUNC_ADD, RL_FUNC_ADD);
+    } else {
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    }
+    
+    BeginTextureMode(cache->target);
+        ClearBackground(BLANK);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+            for (int i = 0; i < cache->entryCount; i++) RM_DrawSurface(cache->entries[i].surface);
+        EndBlendMode();
+    EndTextureMode();
+    
+    memcpy(rm_outputViewports, savedViewports, sizeof(rm_outputViewports));
+    rm_outputViewportCount = savedViewportCount;
+    
+    // State after the draws: they may have picked an automatic resolution or found blend edges
+    for (int i = 0; i < cache->entryCount; i++) {
+        rm_CompositeEntry *e = &cache->entries[i];
+        e->transformSeq = e->surface->transformSeq;
+        e->contentPasses = e->surface->contentPasses;
+        e->meshColumns = e->surface->meshColumns;
+        e->meshRows = e->surface->meshRows;
+        e->gpuWarp = e->surface->gpuWarp;
+        e->blendGamma = e->surface->blendGamma;
+    }
+    cache->blendGeneration = rm_blendGeneration;
+    cache->blendWidth = rm_blendWidth;
+    cache->dirty = false;
+    cache->redraws++;
+}
+
+//--------------------------------------------------------------------------------------------
+// Internal Helper Functions - Calibration
+//--------------------------------------------------------------------------------------------
+
+// Drop the dragged handle, a corner drag hands the surface back its full resolution mesh
+static void rm_EndCalibrationDrag(RM_Calibration *calibration)
+{
+    if (calibration->activeCorner >= 0 && calibration->activeCorner < 4) {
+        RM_SetSurfaceEditing(calibration->surface, false);
+    }
+    calibration->activeCorner = -1;
+}
+
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Surface Management
+//--------------------------------------------------------------------------------------------
+
+// Unload material and render target. UnloadMaterial also unloads the diffuse texture, which
+// is the shared page for atlas surfaces: detach it, the page goes with its last region
+static void rm_UnloadSurfaceTarget(RM_Surface *surface)
+{
+    if (surface->atlasPage && surface->material.maps) {
+        surface->material.maps[MATERIAL_MAP_DIFFUSE].texture.id = rlGetTextureIdDefault();
+    }
+    if (surface->material.shader.id > 0) {
+        UnloadMaterial(surface->material);
+        TraceLog(LOG_DEBUG, "RAYMAP: Material unloaded");
+    }
+    if (surface->atlasPage) {
+        rm_ReleaseAtlasRegion(surface->atlasPage, surface->atlasRect);
+        surface->atlasPage = NULL;
+        TraceLog(LOG_DEBUG, "RAYMAP: Atlas region released");
+    } else if (surface->target.id > 0) {
+        UnloadRenderTexture(surface->target);
+        TraceLog(LOG_DEBUG, "RAYMAP: RenderTexture unloaded");
+    }
+}
+
+static RM_Surface *rm_CreateSurface(int width, int height, RM_MapMode mode, bool atlas)
+{
+    // Validate input
+    if (width <= 0 || width > 8192) {
+        TraceLog(LOG_ERROR, "RAYMAP: Invalid width %d (must be 1-8192)", width);
+        return NULL;
+    }
+    if (height <= 0 || height > 8192) {
+        TraceLog(LOG_ERROR, "RAYMAP: Invalid height %d (must be 1-8192)", height);
+        return NULL;
+    }
+    
+    // Allocate surface
+    RM_Surface *surface = (RM_Surface *)RMMALLOC(sizeof(RM_Surface));
+    if (!surface) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate surface memory");
+        return NULL;
+    }
+    
+    // Initialize fields
+    surface->width = width;
+    surface->height = height;
+    surface->mode = mode;
+    surface->mesh = (Mesh){ 0 };
+    surface->mesh.vertices = NULL;
+    surface->compact = (rm_CompactMesh){ 0 };
+    surface->vertexFormat = RM_VERTEX_DEFAULT;
+    surface->meshBuiltFormat = RM_VERTEX_DEFAULT;
+    surface->indexBuffer = NULL;
+    surface->gpuWarp = false;
+    surface->grid = (rm_ControlGrid){ 0 };
+    surface->gridPublished = NULL;
+    rm_ClearGridDirty(&surface->grid);
+    surface->meshBuiltWarp = false;
+    surface->meshBuiltColumns = 0;
+    surface->meshBuiltRows = 0;
+    surface->editing = false;
+    surface->dynamic = false;
+    for (int i = 0; i < RAYMAP_DYNAMIC_SEGMENTS; i++) surface->positionRing[i] = 0;
+    surface->ringSegment = 0;
+    surface->bufferStats = (RM_BufferStats){ 0 };
+    surface->material = (Material){ 0 };
+    surface->transformSeq = 0;
+    surface->contentGeneration = 1;         // Never drawn: needs a first pass
+    surface->renderedGeneration = 0;
+    surface->contentPasses = 0;
+    surface->dirtyRegion = (Rectangle){ 0.0f, 0.0f, (float)width, (float)height };
+    surface->scissorPass = false;
+    surface->contentStats = (RM_ContentStats){ 0 };
+    surface->updateQueued = false;
+    surface->blendGamma = 0.0f;
+    surface->blendNext = NULL;
+    surface->blendNeighborCount = 0;
+    surface->blendGeneration = 0;
+    
+    // Set default quad (full rectangle)
+    surface->quad = (RM_Quad){
+        { 0.0f, 0.0f },
+        { (float)width, 0.0f },
+        { (float)width, (float)height },
+        { 0.0f, (float)height }
+    };
+    
+    // Flat control lattice on the quad
+    if (mode == RM_MAP_GRID && !rm_ResizeGrid(surface, RM_DEFAULT_GRID_POINTS, RM_DEFAULT_GRID_POINTS, false)) {
+        RMFREE(surface);
+        return NULL;
+    }
+    rm_PublishTransform(surface);
+    
+    // Set mesh resolution
+    rm_GetDefaultResolutionForMode(mode, &surface->meshColumns, &surface->meshRows);
+    surface->meshAuto = false;
+    surface->meshErrorBudget = RAYMAP_MESH_ERROR_BUDGET;
+    surface->meshNeedsUpdate = true;
+    
+    // Create render texture (a region of a shared page for atlas surfaces)
+    surface->atlasPage = NULL;
+    surface->atlasRect = (Rectangle){ 0.0f, 0.0f, (float)width, (float)height };
+    if (atlas) {
+        surface->atlasPage = rm_AcquireAtlasRegion(width, height, &surface->atlasRect);
+        if (surface->atlasPage) {
+            surface->target = surface->atlasPage->target;
+        } else {
+            TraceLog(LOG_WARNING, "RAYMAP: No atlas room for %dx%d surface, using its own render texture", width, height);
+        }
+    }
+    if (!surface->atlasPage) {
+        surface->target = LoadRenderTexture(width, height);
+        if (surface->target.id == 0) {
+            TraceLog(LOG_ERROR, "RAYMAP: Failed to create %dx%d render texture", width, height);
+            rm_FreeGrid(surface);
+            RMFREE(surface);
+            return NULL;
+        }
+    }
+    
+    // Create material
+    surface->material = LoadMaterialDefault();
+    if (surface->material.shader.id == 0) {
+        TraceLog(LOG_WARNING, "RAYMAP: Material shader not properly loaded");
+    }
+    SetMaterialTexture(&surface->material, MATERIAL_MAP_DIFFUSE, surface->target.texture);
+    
+    // Generate initial mesh
+    rm_GenerateBilinearMesh(surface, surface->meshColumns, surface->meshRows);
+    
+    // CRITICAL : Verify mesh was created succefully
+    if (!surface->mesh.vertices || surface->mesh.vboId[0] == 0){
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to generate initial mesh");
+
+        // cleanup reverse order of creation
+        rm_UnloadSurfaceTarget(surface);
+        if (surface->mesh.vertices){
+            rm_CleanupMeshMemory(&surface->mesh);
+        }
+        rm_FreeGrid(surface);
+
+        RMFREE(surface);
+        return NULL;
+    }
+    
+    TraceLog(LOG_INFO, "RAYMAP: Surface created [%dx%d, mode=%s, mesh=%dx%d%s]",
+             width, height,
+             rm_GetMapModeName(mode),
+             surface->meshColumns, surface->meshRows,
+             surface->atlasPage ? ", atlas" : "");
+    
+    return surface;
+}
+
+RMAPI RM_Surface *RM_CreateSurface(int width, int height, RM_MapMode mode)
+{
+    return rm_CreateSurface(width, height, mode, false);
+}
+
+RMAPI RM_Surface *RM_CreateSurfaceInAtlas(int width, int height, RM_MapMode mode)
+{
+    return rm_CreateSurface(width, height, mode, true);
+}
+
+RMAPI void RM_DestroySurface(RM_Surface *surface)
+{
+    if (!surface) {
+        TraceLog(LOG_WARNING, "RAYMAP: Attempted to destroy NULL surface");
+        return;
+    }
+    
+    // Overlapping surfaces lose their ramp towards this one
+    if (surface->blendGamma > 0.0f) {
+        rm_UnlinkBlendSurface(surface);
+        rm_ReleaseBlendShader();
+        rm_blendGeneration++;
+    }
+    
+    // Unload in reverse order of creation
+    rm_UnloadPositionRing(surface, false);
+    rm_UnloadSurfaceMesh(surface);
+    rm_UnloadSurfaceTarget(surface);
+    rm_FreeGrid(surface);
+    
+    // Free surface struct
+    RMFREE(surface);
+    
+    TraceLog(LOG_INFO, "RAYMAP: Surface destroyed");
+}
+
+RMAPI bool RM_SetQuad(RM_Surface *surface, RM_Quad quad)
+{
+    if (!surface) {
+        TraceLog(LOG_WARNING, "RAYMAP: Cannot set quad on NULL surface");
+        return false;
+    }
+    
+    // Validate minimum area
+    float area = RM_GetQuadArea(quad);
+    if (area < 100.0f) {
+        TraceLog(LOG_WARNING, "RAYMAP: Quad too small (area=%.2f), rejected", area);
+        return false;
+    }
+    
+    // Validate distinct corners
+    Vector2 corners[4] = { quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft };
+    for (int i = 0; i < 4; i++) {
+        for (int j = i + 1; j < 4; j++) {
+            float dist = Vector2Distance(corners[i], corners[j]);
+            if (dist < 1.0f) {
+                TraceLog(LOG_WARNING, "RAYMAP: Degenerate quad (corners too close), rejected");
+                return false;
+            }
+        }
+    }
+    
+    // Apply quad (the control lattice follows it)
+    rm_MoveGridWithQuad(&surface->grid, surface->quad, quad);
+    surface->quad = quad;
+    surface->meshNeedsUpdate = true;
+    rm_PublishTransform(surface);
+    
+    return true;
+}
+
+RMAPI RM_Quad RM_GetQuad(const RM_Surface *surface)
+{
+    if (!surface) {
+        return (RM_Quad){ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } };
+    }
+
+    // Read through the snapshot so other threads see a consistent quad
+    rm_Transform t;
+    rm_ReadTransform(surface, &t, RM_TRANSFORM_FORWARD_BEGIN, offsetof(rm_Transform, homography));
+    return t.quad;
+}
+
+RMAPI void RM_GetSurfaceSize(const RM_Surface *surface, int *width, int *height)
+{
+    if (!surface) return;
+    if (width) *width = surface->width;
+    if (height) *height = surface->height;
+}
+
+RMAPI bool RM_IsSurfaceInAtlas(const RM_Surface *surface)
+{
+    if (!surface) return false;
+    return surface->atlasPage != NULL;
+}
+
+RMAPI Rectangle RM_GetSurfaceTextureRect(const RM_Surface *surface)
+{
+    if (!surface) return (Rectangle){ 0 };
+    return surface->atlasRect;
+}
+
+RMAPI void RM_SetMeshResolution(RM_Surface *surface, int columns, int rows)
+{
+    if (!surface) return;
+    
+    // Automatic: resolution picked on next draw, and again after every quad change
+    if (columns == RM_MESH_AUTO || rows == RM_MESH_AUTO) {
+        if (!surface->meshAuto) {
+            surface->meshAuto = true;
+            surface->meshColumns = RM_MESH_AUTO;
+            surface->meshRows = RM_MESH_AUTO;
+            surface->meshNeedsUpdate = true;
+        }
+        return;
+    }
+    
+    // Clamp to valid range
+    if (columns < 4) columns = 4;
+    if (columns > RM_MAX_MESH_RESOLUTION) columns = RM_MAX_MESH_RESOLUTION;
+    if (rows < 4) rows = 4;
+    if (rows > RM_MAX_MESH_RESOLUTION) rows = RM_MAX_MESH_RESOLUTION;
+    
+    // Skip if no change
+    if (!surface->meshAuto && surface->meshColumns == columns && surface->meshRows == rows) {
+        return;
+    }
+    
+    // Update resolution
+    surface->meshAuto = false;
+    surface->meshColumns = columns;
+    surface->meshRows = rows;
+    surface->meshNeedsUpdate = true;
+}
+
+RMAPI void RM_GetMeshResolution(const RM_Surface *surface, int *columns, int *rows)
+{
+    if (!surface) return;
+    if (columns) *columns = surface->meshColumns;
+    if (rows) *rows = surface->meshRows;
+}
+
+RMAPI void RM_SetMeshErrorBudget(RM_Surface *surface, float pixels)
+{
+    if (!surface) return;
+    if (pixels < 0.01f) {
+        TraceLog(LOG_WARNING, "RAYMAP: Mesh error budget %.3f px too small, clamped to 0.01", pixels);
+        pixels = 0.01f;
+    }
+    if (surface->meshErrorBudget == pixels) return;
+    
+    surface->meshErrorBudget = pixels;
+    if (surface->meshAuto) surface->meshNeedsUpdate = true;
+}
+
+RMAPI float RM_GetMeshErrorBudget(const RM_Surface *surface)
+{
+    if (!surface) return 0.0f;
+    return surface->meshErrorBudget;
+}
+
+RMAPI void RM_SetVertexFormat(RM_Surface *surface, RM_VertexFormat format)
+{
+    if (!surface) return;
+    if (format < RM_VERTEX_DEFAULT || format > RM_VERTEX_COMPACT16) {
+        TraceLog(LOG_WARNING, "RAYMAP: Invalid vertex format %d", (int)format);
+        return;
+    }
+    if (surface->vertexFormat == format) return;
+    
+    // Layout change: full rebuild on next draw
+    surface->vertexFormat = format;
+    surface->meshNeedsUpdate = true;
+}
+
+RMAPI RM_VertexFormat RM_GetVertexFormat(const RM_Surface *surface)
+{
+    if (!surface) return RM_VERTEX_DEFAULT;
+    return surface->vertexFormat;
+}
+
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Rendering
+//--------------------------------------------------------------------------------------------
+
+RMAPI void RM_BeginSurface(RM_Surface *surface)
+{
+    if (!surface) return;
+    
+    // Atlas region: viewport and projection of the surface size, scissor so clears stay inside
+    if (surface->atlasPage) {
+        rm_BeginSurfaceArea(surface, (Rectangle){ 0.0f, 0.0f, (float)surface->width, (float)surface->height });
+    } else {
+        BeginTextureMode(surface->target);
+    }
+}
+
+RMAPI void RM_BeginSurfaceRegion(RM_Surface *surface, Rectangle dirty)
+{
+    if (!surface) return;
+
+    Rectangle area = rm_RegionUnion(surface->dirtyRegion, rm_ClipSurfaceRegion(surface, dirty));
+    rm_BeginSurfaceArea(surface, area);
+}
+
+RMAPI void RM_EndSurface(RM_Surface *surface)
+{
+    if (!surface) return;
+    if (surface->scissorPass) {
+        rlDrawRenderBatchActive();
+        rlDisableScissorTest();
+        surface->scissorPass = false;
+    }
+    EndTextureMode();
+
+    surface->renderedGeneration = surface->contentGeneration;
+    surface->dirtyRegion = (Rectangle){ 0 };
+    surface->contentStats.rendered++;
+    surface->contentPasses++;
+}
+
+RMAPI void RM_MarkSurfaceDirty(RM_Surface *surface)
+{
+    if (!surface) return;
+    surface->contentGeneration++;
+    surface->dirtyRegion = (Rectangle){ 0.0f, 0.0f, (float)surface->width, (float)surface->height };
+}
+
+RMAPI void RM_MarkSurfaceRegionDirty(RM_Surface *surface, Rectangle region)
+{
+    if (!surface) return;
+
+    region = rm_ClipSurfaceRegion(surface, region);
+    if (region.width <= 0.0f) return;
+
+    surface->contentGeneration++;
+    surface->dirtyRegion = rm_RegionUnion(surface->dirtyRegion, region);
+}
+
+RMAPI Rectangle RM_GetSurfaceDirtyRegion(const RM_Surface *surface)
+{
+    if (!surface) return (Rectangle){ 0 };
+    return surface->dirtyRegion;
+}
+
+RMAPI bool RM_SurfaceNeedsRedraw(RM_Surface *surface)
+{
+    if (!surface) return false;
+    if (surface->renderedGeneration != surface->contentGeneration) return true;
+
+    surface->contentStats.skipped++;
+    return false;
+}
+
+RMAPI RM_ContentStats RM_GetContentStats(const RM_Surface *surface)
+{
+    if (!surface) return (RM_ContentStats){ 0 };
+    return surface->contentStats;
+}
+
+RMAPI void RM_ResetContentStats(RM_Surface *surface)
+{
+    if (!surface) return;
+    surface->contentStats = (RM_ContentStats){ 0 };
+}
+
+RMAPI void RM_DrawSurface(RM_Surface *surface)
+{
+    if (!surface) {
+        TraceLog(LOG_WARNING, "RAYMAP: Attempted to draw NULL surface");
+        return;
+    }
+    
+    // Culled: no draw and no mesh update until it comes back
+    if (!rm_IsSurfaceVisible(surface)) return;
+    
+    // Lazy update : regenerate mesh if dirty flag is set
+    rm_EnsureMeshUpdated(surface);
+    
+    // Blend ramps follow the quads of overlapping surfaces
+    if (surface->blendGamma > 0.0f) rm_UpdateBlendEdges(surface);
+    
+    // Validate mesh (the shared warp grid is checked when built)
+    if (surface->meshBuiltWarp) {
+        if (!rm_warpShader.refCount) {
+            TraceLog(LOG_ERROR, "RAYMAP: Warp shader not loaded");
+            return;
+        }
+    } else if (surface->meshBuiltFormat == RM_VERTEX_DEFAULT) {
+        if (!surface->mesh.vertices) {
+            TraceLog(LOG_ERROR, "RAYMAP: Surface has no mesh vertices");
+            return;
+        }
+        if (surface->mesh.vboId[0] == 0) {
+            TraceLog(LOG_ERROR, "RAYMAP: Mesh not uploaded to GPU");
+            return;
+        }
+    } else if (surface->compact.vboId == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Compact mesh not uploaded to GPU");
+        return;
+    }
+    if (surface->target.texture.id == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Surface render texture is invalid");
+        return;
+    }
+    if (surface->material.shader.id == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Surface material shader is invalid");
+        return;
+    }
+    
+    // Draw mesh
+    rlDisableDepthTest();
+    rlDisableBackfaceCulling();
+    
+    if (surface->meshBuiltWarp) {
+        rm_DrawWarpGrid(surface);
+    } else if (surface->meshBuiltFormat == RM_VERTEX_DEFAULT) {
+        Material material = surface->material;
+        if (rm_UsesBlendShader(surface)) {
+            material.shader = rm_blendShader.shader;
+            rlEnableShader(material.shader.id);
+            rm_SetBlendUniforms(surface, &rm_blendShader.locs, (Rectangle){ 0.0f, 0.0f, 1.0f, 1.0f });
+        }
+        DrawMesh(surface->mesh, material, MatrixIdentity());
+    } else {
+        rm_DrawCompactMesh(surface);
+    }
+    
+    rlEnableBackfaceCulling();
+    rlEnableDepthTest();
+}
+
+RMAPI void RM_UpdateSurfaces(RM_Surface **surfaces, int count)
+{
+    if (!surfaces || count <= 0) return;
+    
+    rm_MeshJob *jobs = (rm_MeshJob *)RMMALLOC(count * sizeof(rm_MeshJob));
+    if (!jobs) {
+        TraceLog(LOG_WARNING, "RAYMAP: Failed to allocate mesh jobs, updating surfaces one by one");
+    }
+    
+    // Full rewrites and rebuilds become jobs, anything cheaper is done right away
+    int jobCount = 0;
+    for (int i = 0; i < count; i++) {
+        RM_Surface *surface = surfaces[i];
+        if (!surface || surface->updateQueued) continue;
+        
+        // Culled: updated when it comes back, as with RM_DrawSurface
+        if (!rm_IsSurfaceVisible(surface)) continue;
+        
+        // Up to date, moved control points only or GPU warp (no vertex data to compute)
+        if (!jobs || !surface->meshNeedsUpdate || rm_UsesGPUWarp(surface)) {
+            rm_EnsureMeshUpdated(surface);
+            continue;
+        }
+        
+        rm_MeshJob *job = &jobs[jobCount++];
+        *job = (rm_MeshJob){ 0 };
+        job->surface = surface;
+        rm_GetUpdateResolution(surface, &job->cols, &job->rows);
+        job->inPlace = rm_CanUpdateInPlace(surface, job->cols, job->rows);
+        
+        // A full rebuild covers any moved control points
+        if (!job->inPlace) rm_ClearGridDirty(&surface->grid);
+        surface->updateQueued = true;
+    }
+    
+    if (jobCount > 0) {
+        TraceLog(LOG_DEBUG, "RAYMAP: Updating %d surface meshes in parallel", jobCount);
+        rm_RunJobs(rm_RunMeshJob, jobs, jobCount);
+    }
+    
+    // GPU side: uploads and mesh swaps, in array order
+    for (int i = 0; i < jobCount; i++) {
+        rm_MeshJob *job = &jobs[i];
+        job->surface->updateQueued = false;
+        
+        if (job->inPlace) {
+            rm_FinishMeshRewrite(job->surface);
+        } else if (job->build.ready) {
+            rm_CommitMesh(job->surface, &job->build);
+        } else {
+            rm_DiscardMesh(&job->build); // Error already logged, keep old mesh
+        }
+    }
+    
+    if (jobs) RMFREE(jobs);
+}
+
+RMAPI void RM_SetMapMode(RM_Surface *surface, RM_MapMode mode)
+{
+    if (!surface) return;
+    if (surface->mode == mode) return;
+    
+    // First time in grid mode: flat lattice on the quad
+    if (mode == RM_MAP_GRID && !surface->grid.points &&
+        !rm_ResizeGrid(surface, RM_DEFAULT_GRID_POINTS, RM_DEFAULT_GRID_POINTS, false)) {
+        return;
+    }
+    
+    surface->mode = mode;
+    if (!surface->meshAuto) {
+        rm_GetDefaultResolutionForMode(mode, &surface->meshColumns, &surface->meshRows);
+    }
+    surface->meshNeedsUpdate = true;
+    rm_PublishTransform(surface);
+}
+
+RMAPI RM_MapMode RM_GetMapMode(const RM_Surface *surface)
+{
+    if (!surface) return RM_MAP_BILINEAR;
+    return surface->mode;
+}
+
+RMAPI void RM_SetSurfaceDynamic(RM_Surface *surface, bool dynamic)
+{
+    if (!surface) return;
+    if (surface->dynamic == dynamic) return;
+    
+    surface->dynamic = dynamic;
+    
+    // Back to the mesh's own buffer, refreshed with the current positions on next draw
+    if (!dynamic) {
+        rm_UnloadPositionRing(surface, true);
+        surface->meshNeedsUpdate = true;
+    }
+}
+
+RMAPI bool RM_IsSurfaceDynamic(const RM_Surface *surface)
+{
+    if (!surface) return false;
+    return surface->dynamic;
+}
+
+RMAPI void RM_SetSurfaceEditing(RM_Surface *surface, bool editing)
+{
+    if (!surface) return;
+    if (surface->editing == editing) return;
+    
+    surface->editing = editing;
+    
+    // Proxy on the next draw, or the full resolution mesh rebuilt once when editing ends
+    surface->meshNeedsUpdate = true;
+}
+
+RMAPI bool RM_IsSurfaceEditing(const RM_Surface *surface)
+{
+    if (!surface) return false;
+    return surface->editing;
+}
+
+RMAPI RM_BufferStats RM_GetBufferStats(const RM_Surface *surface)
+{
+    if (!surface) return (RM_BufferStats){ 0 };
+    return surface->bufferStats;
+}
+
+RMAPI void RM_ResetBufferStats(RM_Surface *surface)
+{
+    if (!surface) return;
+    surface->bufferStats = (RM_BufferStats){ 0 };
+}
+
+RMAPI void RM_SetSurfaceGPUWarp(RM_Surface *surface, bool enabled)
+{
+    if (!surface) return;
+    if (surface->gpuWarp == enabled) return;
+    
+    // Switch between the shared grid and a per-surface mesh on next draw
+    surface->gpuWarp = enabled;
+    surface->meshNeedsUpdate = true;
+}
+
+RMAPI bool RM_IsSurfaceGPUWarp(const RM_Surface *surface)
+{
+    if (!surface) return false;
+    return rm_UsesGPUWarp(surface);
+}
+
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Control Point Grid
+//--------------------------------------------------------------------------------------------
+
+RMAPI bool RM_SetGridSize(RM_Surface *surface, int columns, int rows)
+{
+    if (!surface) return false;
+    if (columns < 2 || rows < 2 || columns > RM_MAX_GRID_POINTS || rows > RM_MAX_GRID_POINTS) {
+        TraceLog(LOG_WARNING, "RAYMAP: Invalid control grid size %dx%d (must be 2-%d)", columns, rows, RM_MAX_GRID_POINTS);
+        return false;
+    }
+    if (surface->grid.points && surface->grid.columns == columns && surface->grid.rows == rows) return true;
+    
+    if (!rm_ResizeGrid(surface, columns, rows, true)) return false;
+    surface->meshNeedsUpdate = true;
+    rm_PublishTransform(surface);
+    return true;
+}
+
+RMAPI void RM_GetGridSize(const RM_Surface *surface, int *columns, int *rows)
+{
+    if (columns) *columns = (surface && surface->grid.points) ? surface->grid.columns : 0;
+    if (rows) *rows = (surface && surface->grid.points) ? surface->grid.rows : 0;
+}
+
+RMAPI bool RM_SetGridPoint(RM_Surface *surface, int column, int row, Vector2 position)
+{
+    if (!surface || !surface->grid.points) return false;
+    
+    rm_ControlGrid *g = &surface->grid;
+    if (column < 0 || row < 0 || column >= g->columns || row >= g->rows) {
+        TraceLog(LOG_WARNING, "RAYMAP: Control point [%d, %d] out of range", column, row);
+        return false;
+    }
+    
+    Vector2 *p = &g->points[row * g->columns + column];
+    if (p->x == position.x && p->y == position.y) return true;
+    *p = position;
+    rm_UpdateGridMetrics(g);
+    
+    // Only the spans around this point are regenerated on next draw
+    if (column < g->dirtyMinX) g->dirtyMinX = column;
+    if (column > g->dirtyMaxX) g->dirtyMaxX = column;
+    if (row < g->dirtyMinY) g->dirtyMinY = row;
+    if (row > g->dirtyMaxY) g->dirtyMaxY = row;
+    
+    // Batches notice the change through the transform sequence
+    rm_PublishTransform(surface);
+    return true;
+}
+
+RMAPI Vector2 RM_GetGridPoint(const RM_Surface *surface, int column, int row)
+{
+    if (!surface || !surface->grid.points) return (Vector2){ 0.0f, 0.0f };
+    
+    const rm_ControlGrid *g = &surface->grid;
+    if (column < 0 || row < 0 || column >= g->columns || row >= g->rows) return (Vector2){ 0.0f, 0.0f };
+    return g->points[row * g->columns + column];
+}
+
+RMAPI void RM_ResetGrid(RM_Surface *surface)
+{
+    if (!surface || !surface->grid.points) return;
+    
+    if (!rm_ResizeGrid(surface, surface->grid.columns, surface->grid.rows, false)) return;
+    surface->meshNeedsUpdate = true;
+    rm_PublishTransform(surface);
+}
+
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Surface Batching
+//--------------------------------------------------------------------------------------------
+
+RMAPI RM_SurfaceBatch *RM_CreateSurfaceBatch(void)
+{
+    if (!rm_AcquireBatchShader()) {
+        return NULL;  // Error already logged
+    }
+    
+    RM_SurfaceBatch *batch = (RM_SurfaceBatch *)RMCALLOC(1, sizeof(RM_SurfaceBatch));
+    if (!batch) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate surface batch");
+        rm_ReleaseBatchShader();
+        return NULL;
+    }
+    
+    return batch;
+}
+
+RMAPI void RM_DestroySurfaceBatch(RM_SurfaceBatch *batch)
+{
+    if (!batch) return;
+    
+    rm_UnloadBatchBuffers(batch);
+    if (batch->entries) RMFREE(batch->entries);
+    RMFREE(batch);
+    rm_ReleaseBatchShader();
+}
+
+RMAPI bool RM_AddSurfaceToBatch(RM_SurfaceBatch *batch, RM_Surface *surface)
+{
+    if (!batch || !surface) return false;
+    
+    for (int i = 0; i < batch->entryCount; i++) {
+        if (batch->entries[i].surface == surface) return false;
+    }
+    
+    rm_BatchEntry *entries = (rm_BatchEntry *)rm_GrowArray(batch->entries, batch->entryCount, &batch->entryCapacity, sizeof(rm_BatchEntry));
+    if (!entries) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to grow surface batch");
+        return false;
+    }
+    batch->entries = entries;
+    
+    batch->entries[batch->entryCount] = (rm_BatchEntry){ surface, 0, 0, 0, 0, 0, 0 };
+    batch->entryCount++;
+    batch->layoutDirty = true;
+    return true;
+}
+
+RMAPI void RM_RemoveSurfaceFromBatch(RM_SurfaceBatch *batch, RM_Surface *surface)
+{
+    if (!batch || !surface) return;
+    
+    for (int i = 0; i < batch->entryCount; i++) {
+        if (batch->entries[i].surface != surface) continue;
+        
+        rm_RemoveArrayItem(batch->entries, &batch->entryCount, i, sizeof(rm_BatchEntry));
+        batch->layoutDirty = true;
+        return;
+    }
+}
+
+RMAPI void RM_DrawSurfaceBatch(RM_SurfaceBatch *batch)
+{
+    if (!batch) return;
+    
+    // Quad changes rewrite vertices in place, grid changes rebuild the batch
+    for (int i = 0; i < batch->entryCount; i++) {
+        rm_BatchEntry *entry = &batch->entries[i];
+        RM_Surface *surface = entry->surface;
+        
+        // RM_MESH_AUTO grids follow the quad (0x0 until first picked)
+        if (surface->meshAuto && surface->mode != RM_MAP_HOMOGRAPHY &&
+            (entry->transformSeq != surface->transformSeq || surface->meshColumns == 0)) {
+            rm_UpdateAutoResolution(surface);
+        }
+        
+        int cols, rows;
+        rm_GetBatchResolution(surface, &cols, &rows);
+        if (cols != entry->cols || rows != entry->rows) batch->layoutDirty = true;
+    }
+    
+    batch->lastDrawCalls = 0;
+    if (batch->layoutDirty) {
+        if (!rm_BuildBatch(batch)) return;  // Error already logged
+    } else {
+        rm_UpdateBatchVertices(batch);
+    }
+    if (batch->drawCount == 0) return;
+    
+    // Skip draw calls whose surfaces are all culled
+    bool anyVisible = false;
+    for (int d = 0; d < batch->drawCount; d++) batch->draws[d].visible = false;
+    for (int i = 0; i < batch->entryCount; i++) {
+        rm_BatchEntry *entry = &batch->entries[i];
+        if (batch->draws[entry->draw].visible || !rm_IsSurfaceVisible(entry->surface)) continue;
+        batch->draws[entry->draw].visible = true;
+        anyVisible = true;
+    }
+    if (!anyVisible) return;
+    
+    // GL state, shader and uniforms set once for the whole batch
+    rlDisableDepthTest();
+    rlDisableBackfaceCulling();
+    rm_BeginShader(rm_batchShader.shader, WHITE, MatrixIdentity());
+    
+    for (int d = 0; d < batch->drawCount; d++) {
+        const rm_BatchDraw *draw = &batch->draws[d];
+        if (!draw->visible) continue;
+        
+        for (int layer = 0; layer < draw->textureCount; layer++) {
+            rlActiveTextureSlot(layer);
+            rlEnableTexture(draw->textures[layer]);
         }
+        
+        // Without VAO support the layout is bound on every draw
+        if (!rlEnableVertexArray(draw->vaoId)) {
+            rlEnableVertexBuffer(batch->vboId);
+            rm_SetBatchLayout(draw->firstVertex * RM_BATCH_VERTEX_FLOATS * (int)sizeof(float));
+            rlEnableVertexBufferElement(batch->eboId);
+        }
+        
+        rlDrawVertexArrayElements(draw->firstIndex, draw->indexCount, 0);
+        batch->lastDrawCalls++;
     }
     
-    // Upload to GPU
-    UploadMesh(&newMesh, false);
-
-    // CRITICAL : Check upload succeeded BEFORE destroying old
-    if (newMesh.vboId[0] == 0){
-        TraceLog(LOG_ERROR, "RAYMAP: Failed to upload mesh to GPU");
-        rm_CleanupMeshMemory(&newMesh); // Clean up the failed mesh
-        return; // keep old mesh
+    for (int layer = RM_BATCH_MAX_TEXTURES - 1; layer >= 0; layer--) {
+        rlActiveTextureSlot(layer);
+        rlDisableTexture();
     }
+    rm_EndMeshShader();
+    
+    rlEnableBackfaceCulling();
+    rlEnableDepthTest();
+}
 
-    // Upload succeeded -> safge destroy old mesh
-    if (surface->mesh.vertices){
-        UnloadMesh(surface->mesh);
-        TraceLog(LOG_DEBUG, "RAYMAP: Old mesh unloaded");
+RMAPI int RM_GetSurfaceBatchDrawCalls(const RM_SurfaceBatch *batch)
+{
+    if (!batch) return 0;
+    return batch->lastDrawCalls;
+}
+
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Visibility Culling
+//--------------------------------------------------------------------------------------------
+
+RMAPI void RM_SetOutputViewports(const Rectangle *viewports, int count)
+{
+    if (!viewports || count < 0) count = 0;
+    if (count > RM_MAX_OUTPUT_VIEWPORTS) {
+        TraceLog(LOG_WARNING, "RAYMAP: Too many output viewports (%d > %d), extra ignored", count, RM_MAX_OUTPUT_VIEWPORTS);
+        count = RM_MAX_OUTPUT_VIEWPORTS;
     }
     
-    // replace newMesh
-    surface->mesh = newMesh;
-    surface->meshNeedsUpdate = false;
+    for (int i = 0; i < count; i++) rm_outputViewports[i] = viewports[i];
+    rm_outputViewportCount = count;
+}
+
+RMAPI bool RM_IsSurfaceVisible(const RM_Surface *surface)
+{
+    if (!surface) return false;
+    return rm_IsSurfaceVisible(surface);
+}
+
+RMAPI int RM_CullSurfaces(RM_Surface *const *surfaces, int count, bool *visible)
+{
+    if (!surfaces || count <= 0) return 0;
     
-    TraceLog(LOG_INFO, "RAYMAP: Mesh generated successfully [%d vertices, %d triangles]",
-             newMesh.vertexCount, newMesh.triangleCount);
+    int visibleCount = 0;
+    for (int i = 0; i < count; i++) {
+        bool v = surfaces[i] && rm_IsSurfaceVisible(surfaces[i]);
+        if (visible) visible[i] = v;
+        if (v) visibleCount++;
+    }
+    return visibleCount;
 }
 
-// Update mesh if dirty flag is set
-static void rm_EnsureMeshUpdated(RM_Surface *surface)
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Edge Blending
+//--------------------------------------------------------------------------------------------
+
+RMAPI void RM_SetSurfaceBlend(RM_Surface *surface, float gamma)
 {
     if (!surface) {
-        TraceLog(LOG_WARNING, "RAYMAP: Cannot update NULL surface mesh");
+        TraceLog(LOG_WARNING, "RAYMAP: Cannot set blend on NULL surface");
         return;
     }
+    if (!(gamma >= 0.0f)) gamma = 0.0f;
     
-    if (!surface->meshNeedsUpdate) {
-        return;
+    bool blended = (surface->blendGamma > 0.0f);
+    if (gamma > 0.0f && !blended) {
+        if (!rm_AcquireBlendShader()) return;  // Error already logged
+        surface->blendNext = rm_blendSurfaces;
+        rm_blendSurfaces = surface;
+        rm_blendGeneration++;
+    } else if (gamma == 0.0f && blended) {
+        rm_UnlinkBlendSurface(surface);
+        rm_ReleaseBlendShader();
+        rm_blendGeneration++;
     }
     
-    TraceLog(LOG_DEBUG, "RAYMAP: Lazy mesh update triggered");
-    rm_GenerateBilinearMesh(surface, surface->meshColumns, surface->meshRows);
+    surface->blendGamma = gamma;
+}
+
+RMAPI float RM_GetSurfaceBlend(const RM_Surface *surface)
+{
+    if (!surface) return 0.0f;
+    return surface->blendGamma;
+}
+
+RMAPI void RM_SetBlendWidth(float pixels)
+{
+    rm_blendWidth = (pixels > 0.0f) ? pixels : 0.0f;
+}
+
+RMAPI float RM_GetBlendWidth(void)
+{
+    return rm_blendWidth;
+}
+
+RMAPI int RM_GetSurfaceOverlap(const RM_Surface *a, const RM_Surface *b, Vector2 *points, int maxPoints)
+{
+    if (!a || !b || a == b) return 0;
+    
+    Vector2 overlap[64];
+    int count = rm_ClipQuads(a->quad, b->quad, overlap);
+    if (rm_PolygonArea(overlap, count) < RM_BLEND_MIN_OVERLAP) return 0;
+    
+    for (int i = 0; points && i < count && i < maxPoints; i++) points[i] = overlap[i];
+    return count;
+}
+
+RMAPI int RM_GetSurfaceBlendNeighbors(RM_Surface *surface)
+{
+    if (!surface || surface->blendGamma <= 0.0f) return 0;
+    
+    rm_UpdateBlendEdges(surface);
+    return surface->blendNeighborCount;
 }
 
 //--------------------------------------------------------------------------------------------
-// Public API Implementation - Surface Management
+// Public API Implementation - Warp Map
 //--------------------------------------------------------------------------------------------
 
-RMAPI RM_Surface *RM_CreateSurface(int width, int height, RM_MapMode mode)
+RMAPI RM_WarpMap *RM_CreateWarpMap(int width, int height)
 {
-    // Validate input
-    if (width <= 0 || width > 8192) {
-        TraceLog(LOG_ERROR, "RAYMAP: Invalid width %d (must be 1-8192)", width);
+    if (width <= 0 || width > 8192 || height <= 0 || height > 8192) {
+        TraceLog(LOG_ERROR, "RAYMAP: Invalid warp map size %dx%d (must be 1-8192)", width, height);
         return NULL;
     }
-    if (height <= 0 || height > 8192) {
-        TraceLog(LOG_ERROR, "RAYMAP: Invalid height %d (must be 1-8192)", height);
-        return NULL;
+    
+    if (!rm_AcquireWarpMapShader()) {
+        return NULL;  // Error already logged
     }
     
-    // Allocate surface
-    RM_Surface *surface = (RM_Surface *)RMMALLOC(sizeof(RM_Surface));
-    if (!surface) {
-        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate surface memory");
+    RM_WarpMap *map = (RM_WarpMap *)RMCALLOC(1, sizeof(RM_WarpMap));
+    if (map) map->table = (float *)RMCALLOC((size_t)width * height * 3, sizeof(float));
+    if (!map || !map->table) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate warp map [%dx%d]", width, height);
+        if (map) RMFREE(map);
+        rm_ReleaseWarpMapShader();
         return NULL;
     }
+    map->width = width;
+    map->height = height;
     
-    // Initialize fields
-    surface->width = width;
-    surface->height = height;
-    surface->mode = mode;
-    surface->mesh = (Mesh){ 0 };
-    surface->mesh.vertices = NULL;
-    surface->material = (Material){ 0 };
-    surface->homography = rm_Matrix3x3Identity();
-    surface->homographyNeedsUpdate = true;
+    // Float texture, sampled GL_NEAREST (rlLoadTexture default): texels are never interpolated
+    // across surfaces. OpenGL ES 2.0 needs OES_texture_float
+    map->tableId = rlLoadTexture(map->table, width, height, PIXELFORMAT_UNCOMPRESSED_R32G32B32, 1);
+    if (map->tableId == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to load warp map table (float textures not supported?)");
+        RMFREE(map->table);
+        RMFREE(map);
+        rm_ReleaseWarpMapShader();
+        return NULL;
+    }
     
-    // Set default quad (full rectangle)
-    surface->quad = (RM_Quad){
-        { 0.0f, 0.0f },
-        { (float)width, 0.0f },
-        { (float)width, (float)height },
-        { 0.0f, (float)height }
+    // Full-screen quad: screen position, table texcoord
+    float w = (float)width;
+    float h = (float)height;
+    float vertices[6 * 4] = {
+        0.0f, 0.0f, 0.0f, 0.0f,   0.0f, h, 0.0f, 1.0f,   w, h, 1.0f, 1.0f,
+        0.0f, 0.0f, 0.0f, 0.0f,   w, h, 1.0f, 1.0f,      w, 0.0f, 1.0f, 0.0f
     };
+    map->vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(map->vaoId);
+    map->vboId = rlLoadVertexBuffer(vertices, (int)sizeof(vertices), false);
+    rm_SetWarpMapLayout();
+    rlDisableVertexArray();
     
-    // Set mesh resolution
-    rm_GetDefaultResolutionForMode(mode, &surface->meshColumns, &surface->meshRows);
-    surface->meshNeedsUpdate = true;
+    TraceLog(LOG_INFO, "RAYMAP: Warp map created [%dx%d]", width, height);
+    return map;
+}
+
+RMAPI void RM_DestroyWarpMap(RM_WarpMap *map)
+{
+    if (!map) return;
     
-    // Create render texture
-    surface->target = LoadRenderTexture(width, height);
-    if (surface->target.id == 0) {
-        TraceLog(LOG_ERROR, "RAYMAP: Failed to create %dx%d render texture", width, height);
-        RMFREE(surface);
-        return NULL;
+    if (map->vaoId > 0) rlUnloadVertexArray(map->vaoId);
+    if (map->vboId > 0) rlUnloadVertexBuffer(map->vboId);
+    rlUnloadTexture(map->tableId);
+    if (map->entries) RMFREE(map->entries);
+    RMFREE(map->table);
+    RMFREE(map);
+    rm_ReleaseWarpMapShader();
+}
+
+RMAPI bool RM_AddSurfaceToWarpMap(RM_WarpMap *map, RM_Surface *surface)
+{
+    if (!map || !surface) return false;
+    
+    for (int i = 0; i < map->entryCount; i++) {
+        if (map->entries[i].surface == surface) return false;
     }
     
-    // Create material
-    surface->material = LoadMaterialDefault();
-    if (surface->material.shader.id == 0) {
-        TraceLog(LOG_WARNING, "RAYMAP: Material shader not properly loaded");
+    unsigned int texture = surface->target.texture.id;
+    int layer = rm_FindWarpMapTexture(map, texture);
+    if (layer < 0 && map->textureCount == RM_WARP_MAP_MAX_TEXTURES) {
+        TraceLog(LOG_WARNING, "RAYMAP: Warp map already samples %d textures (use atlas surfaces)", RM_WARP_MAP_MAX_TEXTURES);
+        return false;
     }
-    SetMaterialTexture(&surface->material, MATERIAL_MAP_DIFFUSE, surface->target.texture);
     
-    // Generate initial mesh
-    rm_GenerateBilinearMesh(surface, surface->meshColumns, surface->meshRows);
+    rm_WarpMapEntry *entries = (rm_WarpMapEntry *)rm_GrowArray(map->entries, map->entryCount, &map->entryCapacity, sizeof(rm_WarpMapEntry));
+    if (!entries) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to grow warp map");
+        return false;
+    }
+    map->entries = entries;
     
-    // CRITICAL : Verify mesh was created succefully
-    if (!surface->mesh.vertices || surface->mesh.vboId[0] == 0){
-        TraceLog(LOG_ERROR, "RAYMAP: Failed to generate initial mesh");
+    if (layer < 0) {
+        layer = map->textureCount;
+        map->textures[map->textureCount++] = texture;
+    }
+    map->entries[map->entryCount] = (rm_WarpMapEntry){ surface, layer, 0, { 0.0f, 0.0f, 0.0f, 0.0f } };
+    map->entryCount++;
+    map->layoutDirty = true;
+    return true;
+}
 
-        // cleanup reverse order of creation
-        if (surface->material.shader.id > 0){
-            UnloadMaterial(surface->material);
-        }
-        if (surface->target.id > 0){
-            UnloadRenderTexture(surface->target);
-        }
-        if (surface->mesh.vertices){
-            rm_CleanupMeshMemory(&surface->mesh);
+RMAPI void RM_RemoveSurfaceFromWarpMap(RM_WarpMap *map, RM_Surface *surface)
+{
+    if (!map || !surface) return;
+    
+    for (int i = 0; i < map->entryCount; i++) {
+        if (map->entries[i].surface != surface) continue;
+        
+        rm_RemoveArrayItem(map->entries, &map->entryCount, i, sizeof(rm_WarpMapEntry));
+        map->layoutDirty = true;
+        
+        // Compact the texture slots of the remaining surfaces
+        map->textureCount = 0;
+        for (int k = 0; k < map->entryCount; k++) {
+            rm_WarpMapEntry *e = &map->entries[k];
+            unsigned int texture = e->surface->target.texture.id;
+            e->layer = rm_FindWarpMapTexture(map, texture);
+            if (e->layer < 0) {
+                e->layer = map->textureCount;
+                map->textures[map->textureCount++] = texture;
+            }
         }
+        return;
+    }
+}
 
-        RMFREE(surface);
-        return NULL;
+RMAPI void RM_UpdateWarpMap(RM_WarpMap *map)
+{
+    if (!map) return;
+    rm_BakeWarpMap(map);
+}
+
+RMAPI void RM_DrawWarpMap(RM_WarpMap *map)
+{
+    if (!map) return;
+    
+    rm_BakeWarpMap(map);
+    if (map->entryCount == 0) return;
+    
+    // One pass whatever the surface count and mesh resolutions
+    rlDisableDepthTest();
+    rlDisableBackfaceCulling();
+    rm_BeginShader(rm_warpMapShader.shader, WHITE, MatrixIdentity());
+    
+    rlActiveTextureSlot(0);
+    rlEnableTexture(map->tableId);
+    for (int i = 0; i < map->textureCount; i++) {
+        rlActiveTextureSlot(i + 1);
+        rlEnableTexture(map->textures[i]);
     }
     
-    TraceLog(LOG_INFO, "RAYMAP: Surface created [%dx%d, mode=%s, mesh=%dx%d]",
-             width, height,
-             mode == RM_MAP_BILINEAR ? "BILINEAR" : "HOMOGRAPHY",
-             surface->meshColumns, surface->meshRows);
+    // Without VAO support the layout is bound on every draw
+    if (!rlEnableVertexArray(map->vaoId)) {
+        rlEnableVertexBuffer(map->vboId);
+        rm_SetWarpMapLayout();
+    }
+    rlDrawVertexArray(0, 6);
     
-    return surface;
+    for (int slot = map->textureCount; slot >= 0; slot--) {
+        rlActiveTextureSlot(slot);
+        rlDisableTexture();
+    }
+    rm_EndMeshShader();
+    
+    rlEnableBackfaceCulling();
+    rlEnableDepthTest();
 }
 
-RMAPI void RM_DestroySurface(RM_Surface *surface)
+RMAPI Texture2D RM_GetWarpMapTexture(const RM_WarpMap *map)
 {
-    if (!surface) {
-        TraceLog(LOG_WARNING, "RAYMAP: Attempted to destroy NULL surface");
-        return;
+    if (!map) return (Texture2D){ 0 };
+    return (Texture2D){ map->tableId, map->width, map->height, 1, PIXELFORMAT_UNCOMPRESSED_R32G32B32 };
+}
+
+RMAPI int RM_GetWarpMapBakes(const RM_WarpMap *map)
+{
+    if (!map) return 0;
+    return map->bakes;
+}
+
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Output Layout
+//--------------------------------------------------------------------------------------------
+
+RMAPI RM_OutputLayout *RM_CreateOutputLayout(void)
+{
+    RM_OutputLayout *layout = (RM_OutputLayout *)RMCALLOC(1, sizeof(RM_OutputLayout));
+    if (!layout) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate output layout");
+        return NULL;
     }
+    return layout;
+}
+
+RMAPI void RM_DestroyOutputLayout(RM_OutputLayout *layout)
+{
+    if (!layout) return;
     
-    // Unload in reverse order of creation
-    if (surface->mesh.vertices != NULL) {
-        UnloadMesh(surface->mesh);
-        TraceLog(LOG_DEBUG, "RAYMAP: Mesh unloaded");
-    }
-    if (surface->material.shader.id > 0) {
-        UnloadMaterial(surface->material);
-        TraceLog(LOG_DEBUG, "RAYMAP: Material unloaded");
-    }
-    if (surface->target.id > 0) {
-        UnloadRenderTexture(surface->target);
-        TraceLog(LOG_DEBUG, "RAYMAP: RenderTexture unloaded");
+    if (layout->entries) RMFREE(layout->entries);
+    RMFREE(layout);
+}
+
+RMAPI int RM_AddOutput(RM_OutputLayout *layout, RM_Output output)
+{
+    if (!layout || !rm_IsOutputValid(output)) return -1;
+    if (layout->outputCount == RM_MAX_OUTPUT_VIEWPORTS) {
+        TraceLog(LOG_WARNING, "RAYMAP: Too many outputs (max %d)", RM_MAX_OUTPUT_VIEWPORTS);
+        return -1;
     }
     
-    // Free surface struct
-    RMFREE(surface);
+    layout->outputs[layout->outputCount] = output;
+    return layout->outputCount++;
+}
+
+RMAPI bool RM_SetOutput(RM_OutputLayout *layout, int index, RM_Output output)
+{
+    if (!layout || index < 0 || index >= layout->outputCount) return false;
+    if (!rm_IsOutputValid(output)) return false;
     
-    TraceLog(LOG_INFO, "RAYMAP: Surface destroyed");
+    layout->outputs[index] = output;
+    return true;
 }
 
-RMAPI bool RM_SetQuad(RM_Surface *surface, RM_Quad quad)
+RMAPI RM_Output RM_GetOutput(const RM_OutputLayout *layout, int index)
 {
-    if (!surface) {
-        TraceLog(LOG_WARNING, "RAYMAP: Cannot set quad on NULL surface");
+    if (!layout || index < 0 || index >= layout->outputCount) return (RM_Output){ 0 };
+    return layout->outputs[index];
+}
+
+RMAPI int RM_GetOutputCount(const RM_OutputLayout *layout)
+{
+    if (!layout) return 0;
+    return layout->outputCount;
+}
+
+RMAPI bool RM_AssignSurfaceToOutput(RM_OutputLayout *layout, RM_Surface *surface, int output)
+{
+    if (!layout || !surface) return false;
+    if (output != RM_ALL_OUTPUTS && (output < 0 || output >= layout->outputCount)) {
+        TraceLog(LOG_WARNING, "RAYMAP: Output %d out of range", output);
         return false;
     }
     
-    // Validate minimum area
-    float area = RM_GetQuadArea(quad);
-    if (area < 100.0f) {
-        TraceLog(LOG_WARNING, "RAYMAP: Quad too small (area=%.2f), rejected", area);
+    for (int i = 0; i < layout->entryCount; i++) {
+        if (layout->entries[i].surface != surface) continue;
+        layout->entries[i].output = output;
+        return true;
+    }
+    
+    rm_OutputEntry *entries = (rm_OutputEntry *)rm_GrowArray(layout->entries, layout->entryCount, &layout->entryCapacity, sizeof(rm_OutputEntry));
+    if (!entries) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to grow output layout");
         return false;
     }
+    layout->entries = entries;
     
-    // Validate distinct corners
-    Vector2 corners[4] = { quad.topLeft, quad.topRight, quad.bottomRight, quad.bottomLeft };
-    for (int i = 0; i < 4; i++) {
-        for (int j = i + 1; j < 4; j++) {
-            float dist = Vector2Distance(corners[i], corners[j]);
-            if (dist < 1.0f) {
-                TraceLog(LOG_WARNING, "RAYMAP: Degenerate quad (corners too close), rejected");
-                return false;
-            }
+    layout->entries[layout->entryCount] = (rm_OutputEntry){ surface, output };
+    layout->entryCount++;
+    return true;
+}
+
+RMAPI void RM_RemoveSurfaceFromLayout(RM_OutputLayout *layout, RM_Surface *surface)
+{
+    if (!layout || !surface) return;
+    
+    for (int i = 0; i < layout->entryCount; i++) {
+        if (layout->entries[i].surface != surface) continue;
+        
+        rm_RemoveArrayItem(layout->entries, &layout->entryCount, i, sizeof(rm_OutputEntry));
+        return;
+    }
+}
+
+RMAPI int RM_GetSurfaceOutput(const RM_OutputLayout *layout, const RM_Surface *surface)
+{
+    if (!layout || !surface) return RM_NO_OUTPUT;
+    
+    for (int i = 0; i < layout->entryCount; i++) {
+        if (layout->entries[i].surface == surface) return layout->entries[i].output;
+    }
+    return RM_NO_OUTPUT;
+}
+
+RMAPI void RM_DrawOutputLayout(RM_OutputLayout *layout)
+{
+    if (!layout) return;
+    
+    layout->lastDrawCount = 0;
+    for (int o = 0; o < layout->outputCount; o++) {
+        RM_BeginOutput(layout, o);
+        
+        // RM_BeginOutput made the source the culling viewport: off-output surfaces are skipped
+        for (int i = 0; i < layout->entryCount; i++) {
+            RM_Surface *surface = layout->entries[i].surface;
+            int output = layout->entries[i].output;
+            if ((output != o && output != RM_ALL_OUTPUTS) || !rm_IsSurfaceVisible(surface)) continue;
+            
+            RM_DrawSurface(surface);
+            layout->lastDrawCount++;
         }
+        
+        RM_EndOutput();
+    }
+}
+
+RMAPI int RM_GetOutputLayoutDrawCount(const RM_OutputLayout *layout)
+{
+    if (!layout) return 0;
+    return layout->lastDrawCount;
+}
+
+RMAPI void RM_BeginOutput(const RM_OutputLayout *layout, int index)
+{
+    if (!layout || index < 0 || index >= layout->outputCount) {
+        TraceLog(LOG_WARNING, "RAYMAP: Output %d out of range", index);
+        return;
+    }
+    if (rm_outputActive) {
+        TraceLog(LOG_WARNING, "RAYMAP: RM_BeginOutput called twice, missing RM_EndOutput");
+        return;
     }
     
-    // Apply quad
-    surface->quad = quad;
-    surface->meshNeedsUpdate = true;
-    surface->homographyNeedsUpdate = true;
+    RM_Output output = layout->outputs[index];
+    int width, height;
+    rm_GetOutputRegion(output, &width, &height);
+    
+    // Pending draws belong to the previous viewport
+    rlDrawRenderBatchActive();
+    
+    // Framebuffer rectangle (y up)
+    int x = output.x;
+    int y = rlGetFramebufferHeight() - output.y - height;
+    rlViewport(x, y, width, height);
+    rlEnableScissorTest();
+    rlScissor(x, y, width, height);
+    
+    // Source rectangle scaled to output pixels, rotated into the region
+    Rectangle source = rm_GetOutputSource(output);
+    rlMatrixMode(RL_PROJECTION);
+    rlPushMatrix();
+    rlLoadIdentity();
+    rlOrtho(0.0, (double)width, (double)height, 0.0, 0.0, 1.0);
+    
+    // Saved by value: a modelview rlPushMatrix stacks the transform matrix, not the modelview
+    rm_savedModelview = rlGetMatrixModelview();
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+    Vector2 origin = rm_RotateToRegion(output, (Vector2){ 0.0f, 0.0f });
+    rlTranslatef(origin.x, origin.y, 0.0f);
+    rlRotatef((float)output.rotation, 0.0f, 0.0f, 1.0f);
+    rlScalef((float)output.width / source.width, (float)output.height / source.height, 1.0f);
+    rlTranslatef(-source.x, -source.y, 0.0f);
+    
+    // Culling follows the output
+    memcpy(rm_savedViewports, rm_outputViewports, sizeof(rm_outputViewports));
+    rm_savedViewportCount = rm_outputViewportCount;
+    rm_outputViewports[0] = source;
+    rm_outputViewportCount = 1;
+    rm_outputActive = true;
+}
+
+RMAPI void RM_EndOutput(void)
+{
+    if (!rm_outputActive) return;
+    
+    rlDrawRenderBatchActive();
+    
+    rlMatrixMode(RL_PROJECTION);
+    rlPopMatrix();
+    rlMatrixMode(RL_MODELVIEW);
+    rlSetMatrixModelview(rm_savedModelview);
+    
+    // rlgl cannot report the previous viewport and scissor: back to the whole current target
+    rlDisableScissorTest();
+    rlViewport(0, 0, rlGetFramebufferWidth(), rlGetFramebufferHeight());
+    
+    memcpy(rm_outputViewports, rm_savedViewports, sizeof(rm_outputViewports));
+    rm_outputViewportCount = rm_savedViewportCount;
+    rm_outputActive = false;
+}
+
+RMAPI Vector2 RM_WindowToOutput(const RM_OutputLayout *layout, int index, Vector2 point)
+{
+    if (!layout || index < 0 || index >= layout->outputCount) return (Vector2){ -1.0f, -1.0f };
+    
+    RM_Output output = layout->outputs[index];
+    Rectangle source = rm_GetOutputSource(output);
+    Vector2 p = rm_RotateFromRegion(output, (Vector2){ point.x - (float)output.x, point.y - (float)output.y });
+    return (Vector2){ source.x + p.x * source.width / (float)output.width,
+                      source.y + p.y * source.height / (float)output.height };
+}
+
+RMAPI Vector2 RM_OutputToWindow(const RM_OutputLayout *layout, int index, Vector2 point)
+{
+    if (!layout || index < 0 || index >= layout->outputCount) return (Vector2){ -1.0f, -1.0f };
     
-    return true;
+    RM_Output output = layout->outputs[index];
+    Rectangle source = rm_GetOutputSource(output);
+    Vector2 p = { (point.x - source.x) * (float)output.width / source.width,
+                  (point.y - source.y) * (float)output.height / source.height };
+    Vector2 r = rm_RotateToRegion(output, p);
+    return (Vector2){ r.x + (float)output.x, r.y + (float)output.y };
 }
 
-RMAPI RM_Quad RM_GetQuad(const RM_Surface *surface)
+//--------------------------------------------------------------------------------------------
+// Public API Implementation - Composite Cache
+//--------------------------------------------------------------------------------------------
+
+RMAPI RM_CompositeCache *RM_CreateCompositeCache(int width, int height)
 {
-    if (!surface) {
-        return (RM_Quad){ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } };
+    if (width <= 0 || width > 8192 || height <= 0 || height > 8192) {
+        TraceLog(LOG_ERROR, "RAYMAP: Invalid composite cache size %dx%d (must be 1-8192)", width, height);
+        return NULL;
+    }
+    
+    RM_CompositeCache *cache = (RM_CompositeCache *)RMCALLOC(1, sizeof(RM_CompositeCache));
+    if (!cache) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate composite cache");
+        return NULL;
     }
-    return surface->quad;
+    
+    cache->target = LoadRenderTexture(width, height);
+    if (cache->target.id == 0) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to create composite cache render texture");
+        RMFREE(cache);
+        return NULL;
+    }
+    cache->width = width;
+    cache->height = height;
+    cache->dirty = true;
+    
+    TraceLog(LOG_INFO, "RAYMAP: Composite cache created [%dx%d]", width, height);
+    return cache;
 }
 
-RMAPI void RM_GetSurfaceSize(const RM_Surface *surface, int *width, int *height)
+RMAPI void RM_DestroyCompositeCache(RM_CompositeCache *cache)
 {
-    if (!surface) return;
-    if (width) *width = surface->width;
-    if (height) *height = surface->height;
+    if (!cache) return;
+    
+    UnloadRenderTexture(cache->target);
+    if (cache->entries) RMFREE(cache->entries);
+    RMFREE(cache);
 }
 
-RMAPI void RM_SetMeshResolution(RM_Surface *surface, int columns, int rows)
+RMAPI bool RM_AddSurfaceToCompositeCache(RM_CompositeCache *cache, RM_Surface *surface)
 {
-    if (!surface) return;
+    if (!cache || !surface) return false;
     
-    // Clamp to valid range
-    if (columns < 4) columns = 4;
-    if (columns > 64) columns = 64;
-    if (rows < 4) rows = 4;
-    if (rows > 64) rows = 64;
+    for (int i = 0; i < cache->entryCount; i++) {
+        if (cache->entries[i].surface == surface) return false;
+    }
     
-    // Skip if no change
-    if (surface->meshColumns == columns && surface->meshRows == rows) {
-        return;
+    rm_CompositeEntry *entries = (rm_CompositeEntry *)rm_GrowArray(cache->entries, cache->entryCount, &cache->entryCapacity, sizeof(rm_CompositeEntry));
+    if (!entries) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to grow composite cache");
+        return false;
     }
+    cache->entries = entries;
     
-    // Update resolution
-    surface->meshColumns = columns;
-    surface->meshRows = rows;
-    surface->meshNeedsUpdate = true;
+    cache->entries[cache->entryCount] = (rm_CompositeEntry){ surface, 0, 0, 0, 0, false, 0.0f };
+    cache->entryCount++;
+    cache->dirty = true;
+    return true;
 }
 
-RMAPI void RM_GetMeshResolution(const RM_Surface *surface, int *columns, int *rows)
+RMAPI void RM_RemoveSurfaceFromCompositeCache(RM_CompositeCache *cache, RM_Surface *surface)
 {
-    if (!surface) return;
-    if (columns) *columns = surface->meshColumns;
-    if (rows) *rows = surface->meshRows;
+    if (!cache || !surface) return;
+    
+    for (int i = 0; i < cache->entryCount; i++) {
+        if (cache->entries[i].surface != surface) continue;
+        
+        rm_RemoveArrayItem(cache->entries, &cache->entryCount, i, sizeof(rm_CompositeEntry));
+        cache->dirty = true;
+        return;
+    }
 }
 
-//--------------------------------------------------------------------------------------------
-// Public API Implementation - Rendering
-//--------------------------------------------------------------------------------------------
+RMAPI void RM_UpdateCompositeCache(RM_CompositeCache *cache)
+{
+    if (!cache) return;
+    if (rm_CompositeCacheChanged(cache)) rm_RedrawCompositeCache(cache);
+}
 
-RMAPI void RM_BeginSurface(RM_Surface *surface)
+RMAPI void RM_SetCompositeCacheAdditive(RM_CompositeCache *cache, bool additive)
 {
-    if (!surface) return;
-    BeginTextureMode(surface->target);
+    if (!cache || cache->additive == additive) return;
+    cache->additive = additive;
+    cache->dirty = true;
 }
 
-RMAPI void RM_EndSurface(RM_Surface *surface)
+RMAPI void RM_InvalidateCompositeCache(RM_CompositeCache *cache)
 {
-    if (!surface) return;
-    EndTextureMode();
+    if (!cache) return;
+    cache->dirty = true;
 }
 
-RMAPI void RM_DrawSurface(RM_Surface *surface)
+RMAPI void RM_DrawCompositeCache(const RM_CompositeCache *cache)
 {
-    if (!surface) {
-        TraceLog(LOG_WARNING, "RAYMAP: Attempted to draw NULL surface");
-        return;
-    }
-    
-    // Lazy update : regenerate mesh if dirty flag is set
-    rm_EnsureMeshUpdated(surface);
-    
-    // Validate mesh
-    if (!surface->mesh.vertices) {
-        TraceLog(LOG_ERROR, "RAYMAP: Surface has no mesh vertices");
-        return;
-    }
-    if (surface->mesh.vboId[0] == 0) {
-        TraceLog(LOG_ERROR, "RAYMAP: Mesh not uploaded to GPU");
-        return;
-    }
-    if (surface->target.texture.id == 0) {
-        TraceLog(LOG_ERROR, "RAYMAP: Surface render texture is invalid");
-        return;
-    }
-    if (surface->material.shader.id == 0) {
-        TraceLog(LOG_ERROR, "RAYMAP: Surface material shader is invalid");
-        return;
-    }
-    
-    // Draw mesh
-    rlDisableDepthTest();
-    rlDisableBackfaceCulling();
+    if (!cache || cache->entryCount == 0) return;
     
-    DrawMesh(surface->mesh, surface->material, MatrixIdentity());
+    // Render textures are stored upside down: negative source height flips them back
+    Rectangle source = { 0.0f, 0.0f, (float)cache->width, -(float)cache->height };
     
-    rlEnableBackfaceCulling();
-    rlEnableDepthTest();
+    // Premultiplied color: alpha composites with BLEND_ALPHA_PREMULTIPLY, additive light adds
+    // the color as is (BLEND_ADDITIVE would weigh it by alpha a second time)
+    BeginBlendMode(cache->additive ? BLEND_ADD_COLORS : BLEND_ALPHA_PREMULTIPLY);
+        DrawTextureRec(cache->target.texture, source, (Vector2){ 0.0f, 0.0f }, WHITE);
+    EndBlendMode();
 }
 
-RMAPI void RM_SetMapMode(RM_Surface *surface, RM_MapMode mode)
+RMAPI Texture2D RM_GetCompositeCacheTexture(const RM_CompositeCache *cache)
 {
-    if (!surface) return;
-    if (surface->mode == mode) return;
-    
-    surface->mode = mode;
-    rm_GetDefaultResolutionForMode(mode, &surface->meshColumns, &surface->meshRows);
-    surface->meshNeedsUpdate = true;
-    surface->homographyNeedsUpdate = true;
+    if (!cache) return (Texture2D){ 0 };
+    return cache->target.texture;
 }
 
-RMAPI RM_MapMode RM_GetMapMode(const RM_Surface *surface)
+RMAPI int RM_GetCompositeCacheRedraws(const RM_CompositeCache *cache)
 {
-    if (!surface) return RM_MAP_BILINEAR;
-    return surface->mode;
+    if (!cache) return 0;
+    return cache->redraws;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1117,13 +6473,19 @@ RMAPI void RM_ToggleCalibration(RM_Calibration *calibration)
     if (!calibration) return;
     calibration->enabled = !calibration->enabled;
     if (!calibration->enabled) {
-        calibration->activeCorner = -1;
+        rm_EndCalibrationDrag(calibration);
     }
 }
 
 RMAPI void RM_UpdateCalibration(RM_Calibration *calibration)
 {
-    if (!calibration || !calibration->surface || !calibration->enabled) return;
+    if (!calibration || !calibration->surface) return;
+    
+    // Disabled mid-drag: drop the handle so the surface gets its full mesh back
+    if (!calibration->enabled) {
+        if (calibration->activeCorner >= 0) rm_EndCalibrationDrag(calibration);
+        return;
+    }
     
     RM_Quad quad = RM_GetQuad(calibration->surface);
     Vector2 mousePos = GetMousePosition();
@@ -1148,25 +6510,51 @@ RMAPI void RM_UpdateCalibration(RM_Calibration *calibration)
                 break;
             }
         }
+        
+        // Control points, only when no corner was hit (corners move the whole lattice)
+        const rm_ControlGrid *grid = &calibration->surface->grid;
+        if (calibration->activeCorner < 0 && calibration->surface->mode == RM_MAP_GRID && grid->points) {
+            for (int i = 0; i < grid->columns * grid->rows; i++) {
+                float dist = Vector2Distance(mousePos, grid->points[i]);
+                if (dist <= cornerRadius) {
+                    calibration->activeCorner = 4 + i;
+                    calibration->dragOffset = Vector2Subtract(grid->points[i], mousePos);
+                    break;
+                }
+            }
+        }
     }
     
-    // Drag active corner
+    // Drag active corner or control point
     if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && calibration->activeCorner >= 0) {
         Vector2 newPos = Vector2Add(mousePos, calibration->dragOffset);
         
+        if (calibration->activeCorner >= 4) {
+            int index = calibration->activeCorner - 4;
+            int columns = calibration->surface->grid.columns;
+            RM_SetGridPoint(calibration->surface, index % columns, index / columns, newPos);
+            return;
+        }
+        
+        Vector2 *corner = NULL;
         switch (calibration->activeCorner) {
-            case 0: quad.topLeft = newPos; break;
-            case 1: quad.topRight = newPos; break;
-            case 2: quad.bottomRight = newPos; break;
-            case 3: quad.bottomLeft = newPos; break;
+            case 0: corner = &quad.topLeft; break;
+            case 1: corner = &quad.topRight; break;
+            case 2: corner = &quad.bottomRight; break;
+            case 3: corner = &quad.bottomLeft; break;
         }
         
-        RM_SetQuad(calibration->surface, quad);
+        // Proxy mesh once the corner actually moves (a click alone keeps the full mesh)
+        if (corner && (corner->x != newPos.x || corner->y != newPos.y)) {
+            *corner = newPos;
+            RM_SetSurfaceEditing(calibration->surface, true);
+            RM_SetQuad(calibration->surface, quad);
+        }
     }
     
     // Release corner
     if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
-        calibration->activeCorner = -1;
+        rm_EndCalibrationDrag(calibration);
     }
 }
 
@@ -1206,6 +6594,19 @@ RMAPI void RM_DrawCalibrationCorners(RM_Calibration calibration)
         quad.bottomLeft
     };
     
+    // Control point handles, drawn under the corners
+    const rm_ControlGrid *grid = &calibration.surface->grid;
+    if (calibration.surface->mode == RM_MAP_GRID && grid->points) {
+        for (int i = 0; i < grid->columns * grid->rows; i++) {
+            Color color = (4 + i == calibration.activeCorner)
+                ? cfg.selectedCornerColor
+                : cfg.cornerColor;
+            
+            DrawCircleV(grid->points[i], cfg.cornerRadius * 0.5f, ColorAlpha(color, 0.8f));
+            DrawCircleLines((int)grid->points[i].x, (int)grid->points[i].y, cfg.cornerRadius * 0.5f, WHITE);
+        }
+    }
+    
     for (int i = 0; i < 4; i++) {
         Color color = (i == calibration.activeCorner) 
             ? cfg.selectedCornerColor 
@@ -1229,6 +6630,31 @@ RMAPI void RM_DrawCalibrationGrid(RM_Calibration calibration)
     RM_Quad quad = RM_GetQuad(calibration.surface);
     RM_CalibrationConfig cfg = calibration.config;
     
+    // Grid mode: iso-lines of the spline surface as polylines
+    const rm_ControlGrid *grid = &calibration.surface->grid;
+    if (calibration.surface->mode == RM_MAP_GRID && grid->points) {
+        const int segments = 32;
+        for (int x = 0; x <= cfg.gridResolutionX; x++) {
+            float u = (float)x / (float)cfg.gridResolutionX;
+            Vector2 prev = rm_EvaluateGrid(grid, u, 0.0f, NULL, NULL);
+            for (int s = 1; s <= segments; s++) {
+                Vector2 next = rm_EvaluateGrid(grid, u, (float)s / segments, NULL, NULL);
+                DrawLineV(prev, next, cfg.gridColor);
+                prev = next;
+            }
+        }
+        for (int y = 0; y <= cfg.gridResolutionY; y++) {
+            float v = (float)y / (float)cfg.gridResolutionY;
+            Vector2 prev = rm_EvaluateGrid(grid, 0.0f, v, NULL, NULL);
+            for (int s = 1; s <= segments; s++) {
+                Vector2 next = rm_EvaluateGrid(grid, (float)s / segments, v, NULL, NULL);
+                DrawLineV(prev, next, cfg.gridColor);
+                prev = next;
+            }
+        }
+        return;
+    }
+    
     // Horizontal lines
     for (int x = 0; x <= cfg.gridResolutionX; x++) {
         float u = (float)x / (float)cfg.gridResolutionX;
@@ -1322,13 +6748,12 @@ RMAPI bool RM_SaveConfig(const RM_Surface *surface, const char *filepath)
     
     // Mapping mode
     fprintf(file, "[Mode]\n");
-    fprintf(file, "mode=%s\n\n", 
-            surface->mode == RM_MAP_BILINEAR ? "BILINEAR" : "HOMOGRAPHY");
+    fprintf(file, "mode=%s\n\n", rm_GetMapModeName(surface->mode));
     
     // Mesh resolution
     fprintf(file, "[Mesh]\n");
-    fprintf(file, "columns=%d\n", surface->meshColumns);
-    fprintf(file, "rows=%d\n\n", surface->meshRows);
+    fprintf(file, "columns=%d\n", surface->meshAuto ? RM_MESH_AUTO : surface->meshColumns);
+    fprintf(file, "rows=%d\n\n", surface->meshAuto ? RM_MESH_AUTO : surface->meshRows);
     
     // Quad corners
     fprintf(file, "[Quad]\n");
@@ -1337,6 +6762,17 @@ RMAPI bool RM_SaveConfig(const RM_Surface *surface, const char *filepath)
     fprintf(file, "bottomRight=%.2f,%.2f\n", surface->quad.bottomRight.x, surface->quad.bottomRight.y);
     fprintf(file, "bottomLeft=%.2f,%.2f\n", surface->quad.bottomLeft.x, surface->quad.bottomLeft.y);
     
+    // Control points (row-major, after the quad they follow)
+    const rm_ControlGrid *g = &surface->grid;
+    if (g->points) {
+        fprintf(file, "\n[Grid]\n");
+        fprintf(file, "gridColumns=%d\n", g->columns);
+        fprintf(file, "gridRows=%d\n", g->rows);
+        for (int i = 0; i < g->columns * g->rows; i++) {
+            fprintf(file, "point=%.2f,%.2f\n", g->points[i].x, g->points[i].y);
+        }
+    }
+    
     fclose(file);
     
     TraceLog(LOG_INFO, "RAYMAP: Configuration saved to '%s'", filepath);
@@ -1362,6 +6798,9 @@ RMAPI bool RM_LoadConfig(RM_Surface *surface, const char *filepath)
     int meshRows = surface->meshRows;
     RM_MapMode mode = surface->mode;
     bool quadLoaded = false;
+    int gridColumns = 0, gridRows = 0;
+    Vector2 *gridPoints = NULL;
+    int gridCapacity = 0, gridLoaded = 0;
     
     while (fgets(line, sizeof(line), file)) {
         // Remove newline
@@ -1386,6 +6825,8 @@ RMAPI bool RM_LoadConfig(RM_Surface *surface, const char *filepath)
                 mode = RM_MAP_BILINEAR;
             } else if (strcmp(value, "HOMOGRAPHY") == 0) {
                 mode = RM_MAP_HOMOGRAPHY;
+            } else if (strcmp(value, "GRID") == 0) {
+                mode = RM_MAP_GRID;
             }
         }
         else if (strcmp(key, "columns") == 0) {
@@ -1408,23 +6849,58 @@ RMAPI bool RM_LoadConfig(RM_Surface *surface, const char *filepath)
         else if (strcmp(key, "bottomLeft") == 0) {
             sscanf(value, "%f,%f", &quad.bottomLeft.x, &quad.bottomLeft.y);
         }
+        else if (strcmp(key, "gridColumns") == 0) {
+            gridColumns = atoi(value);
+        }
+        else if (strcmp(key, "gridRows") == 0) {
+            gridRows = atoi(value);
+        }
+        else if (strcmp(key, "point") == 0) {
+            if (!gridPoints && gridColumns >= 2 && gridRows >= 2 &&
+                gridColumns <= RM_MAX_GRID_POINTS && gridRows <= RM_MAX_GRID_POINTS) {
+                gridCapacity = gridColumns * gridRows;
+                gridPoints = (Vector2 *)RMMALLOC(gridCapacity * sizeof(Vector2));
+            }
+            if (gridPoints && gridLoaded < gridCapacity &&
+                sscanf(value, "%f,%f", &gridPoints[gridLoaded].x, &gridPoints[gridLoaded].y) == 2) {
+                gridLoaded++;
+            }
+        }
     }
     
     fclose(file);
     
     if (!quadLoaded) {
         TraceLog(LOG_WARNING, "RAYMAP: LoadConfig - No quad data found");
+        if (gridPoints) RMFREE(gridPoints);
         return false;
     }
     
     // Apply configuration
     surface->mode = mode;
-    surface->meshColumns = meshCols;
-    surface->meshRows = meshRows;
+    surface->meshAuto = (meshCols == RM_MESH_AUTO || meshRows == RM_MESH_AUTO);
+    surface->meshColumns = surface->meshAuto ? RM_MESH_AUTO : meshCols;
+    surface->meshRows = surface->meshAuto ? RM_MESH_AUTO : meshRows;
     surface->meshNeedsUpdate = true;
-    surface->homographyNeedsUpdate = true;
     
-    RM_SetQuad(surface, quad);
+    // Publishes the transform for the new mode, or for the old quad if the new one is rejected
+    if (!RM_SetQuad(surface, quad)) rm_PublishTransform(surface);
+    
+    // Control points are absolute: they replace the lattice the quad just moved
+    if (gridPoints && gridLoaded == gridColumns * gridRows && gridLoaded == gridCapacity &&
+        rm_ResizeGrid(surface, gridColumns, gridRows, false)) {
+        memcpy(surface->grid.points, gridPoints, gridLoaded * sizeof(Vector2));
+        rm_UpdateGridMetrics(&surface->grid);
+    } else if (gridPoints) {
+        TraceLog(LOG_WARNING, "RAYMAP: LoadConfig - Incomplete control grid ignored");
+    }
+    if (gridPoints) RMFREE(gridPoints);
+    
+    if (surface->mode == RM_MAP_GRID && !surface->grid.points &&
+        !rm_ResizeGrid(surface, RM_DEFAULT_GRID_POINTS, RM_DEFAULT_GRID_POINTS, false)) {
+        surface->mode = RM_MAP_BILINEAR;
+    }
+    rm_PublishTransform(surface);
     
     TraceLog(LOG_INFO, "RAYMAP: Configuration loaded from '%s'", filepath);
     return true;
@@ -1494,62 +6970,133 @@ RMAPI float RM_GetQuadArea(RM_Quad quad)
     return area;
 }
 
+RMAPI int RM_ComputeHomographies(const RM_Quad *quads, int count, float *matrices)
+{
+    if (!quads || !matrices || count <= 0) return 0;
+
+    int degenerate = 0;
+    int i = 0;
+
+#if defined(RM_SIMD_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        int mask = rm_SquareToQuad4(&quads[i], &matrices[i * 9]);
+        degenerate += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (!rm_SquareToQuad(&quads[i], &matrices[i * 9])) degenerate++;
+    }
+
+    if (degenerate > 0) {
+        TraceLog(LOG_WARNING, "RAYMAP: %d of %d homographies degenerate, set to identity", degenerate, count);
+    }
+
+    return count - degenerate;
+}
+
 //--------------------------------------------------------------------------------------------
 // Public API Implementation - Point Mapping
 //--------------------------------------------------------------------------------------------
 
-RMAPI Vector2 RM_MapPoint(RM_Surface *surface, Vector2 texturePoint)
+RMAPI Vector2 RM_MapPoint(const RM_Surface *surface, Vector2 texturePoint)
 {
     if (!surface) {
         return (Vector2){ -1.0f, -1.0f };
     }
     
     // Clamp to [0,1]
-    float u = fmaxf(0.0f, fminf(1.0f, texturePoint.x));
-    float v = fmaxf(0.0f, fminf(1.0f, texturePoint.y));
+    float u = rm_Clamp01(texturePoint.x);
+    float v = rm_Clamp01(texturePoint.y);
     
-    if (surface->mode == RM_MAP_HOMOGRAPHY) {
-        if (surface->homographyNeedsUpdate) {
-            surface->homography = rm_ComputeHomography(surface->quad);
-            surface->homographyNeedsUpdate = false;
-        }
-        return rm_ApplyHomography(surface->homography, u, v);
+    rm_Transform t;
+    Vector2 gridPoints[RM_MAX_GRID_POINTS * RM_MAX_GRID_POINTS];
+    rm_ReadTransformGrid(surface, &t, RM_TRANSFORM_FORWARD_BEGIN, RM_TRANSFORM_FORWARD_END, gridPoints);
+    
+    if (t.mode == RM_MAP_HOMOGRAPHY) {
+        return rm_ApplyHomography(t.homography, u, v);
+    } else if (t.mode == RM_MAP_GRID) {
+        rm_ControlGrid g = rm_GetGridSnapshot(&t, gridPoints);
+        return rm_EvaluateGrid(&g, u, v, NULL, NULL);
     } else {
         return rm_BilinearInterpolation(
-            surface->quad.topLeft,
-            surface->quad.topRight,
-            surface->quad.bottomLeft,
-            surface->quad.bottomRight,
+            t.quad.topLeft,
+            t.quad.topRight,
+            t.quad.bottomLeft,
+            t.quad.bottomRight,
             u, v
         );
     }
 }
 
-RMAPI Vector2 RM_UnmapPoint(RM_Surface *surface, Vector2 screenPoint)
+RMAPI Vector2 RM_UnmapPoint(const RM_Surface *surface, Vector2 screenPoint)
 {
     if (!surface) {
         return (Vector2){ -1.0f, -1.0f };
     }
     
-    // Check if point is inside quad
-    if (!RM_PointInQuad(screenPoint, surface->quad)) {
-        return (Vector2){ -1.0f, -1.0f };
-    }
+    rm_Transform t;
+    Vector2 gridPoints[RM_MAX_GRID_POINTS * RM_MAX_GRID_POINTS];
+    rm_ReadTransformGrid(surface, &t, RM_TRANSFORM_INVERSE_BEGIN, RM_TRANSFORM_INVERSE_END, gridPoints);
     
-    // Use inverse homography (works for both modes)
-    if (surface->homographyNeedsUpdate) {
-        surface->homography = rm_ComputeHomography(surface->quad);
-        surface->homographyNeedsUpdate = false;
+    // Inside test and inverse both come from the cached transform
+    if (t.mode == RM_MAP_BILINEAR) {
+        return rm_UnmapPointBilinear(&t.edges, &t.invBilinear, screenPoint);
+    }
+    if (t.mode == RM_MAP_GRID) {
+        rm_ControlGrid g = rm_GetGridSnapshot(&t, gridPoints);
+        return rm_UnmapPointGrid(&g, screenPoint);
+    }
+    return rm_UnmapPointInverse(&t.edges, t.inverse, screenPoint);
+}
+
+RMAPI void RM_MapPoints(const RM_Surface *surface, const Vector2 *texturePoints, Vector2 *screenPoints, int count)
+{
+    if (!texturePoints || !screenPoints || count <= 0) return;
+
+    if (!surface) {
+        for (int i = 0; i < count; i++) screenPoints[i] = (Vector2){ -1.0f, -1.0f };
+        return;
+    }
+
+    // One snapshot for the whole batch, so every point sees the same quad
+    rm_Transform t;
+    Vector2 gridPoints[RM_MAX_GRID_POINTS * RM_MAX_GRID_POINTS];
+    rm_ReadTransformGrid(surface, &t, RM_TRANSFORM_FORWARD_BEGIN, RM_TRANSFORM_FORWARD_END, gridPoints);
+
+    if (t.mode == RM_MAP_HOMOGRAPHY) {
+        rm_MapPointsHomography(t.homography, texturePoints, screenPoints, count);
+    } else if (t.mode == RM_MAP_GRID) {
+        rm_ControlGrid g = rm_GetGridSnapshot(&t, gridPoints);
+        for (int i = 0; i < count; i++) {
+            screenPoints[i] = rm_EvaluateGrid(&g, rm_Clamp01(texturePoints[i].x), rm_Clamp01(texturePoints[i].y), NULL, NULL);
+        }
+    } else {
+        rm_MapPointsBilinear(t.quad, texturePoints, screenPoints, count);
+    }
+}
+
+RMAPI void RM_UnmapPoints(const RM_Surface *surface, const Vector2 *screenPoints, Vector2 *texturePoints, int count)
+{
+    if (!screenPoints || !texturePoints || count <= 0) return;
+
+    if (!surface) {
+        for (int i = 0; i < count; i++) texturePoints[i] = (Vector2){ -1.0f, -1.0f };
+        return;
+    }
+
+    rm_Transform t;
+    Vector2 gridPoints[RM_MAX_GRID_POINTS * RM_MAX_GRID_POINTS];
+    rm_ReadTransformGrid(surface, &t, RM_TRANSFORM_INVERSE_BEGIN, RM_TRANSFORM_INVERSE_END, gridPoints);
+
+    if (t.mode == RM_MAP_BILINEAR) {
+        rm_UnmapPointsBilinear(&t.edges, &t.invBilinear, screenPoints, texturePoints, count);
+    } else if (t.mode == RM_MAP_GRID) {
+        rm_ControlGrid g = rm_GetGridSnapshot(&t, gridPoints);
+        for (int i = 0; i < count; i++) texturePoints[i] = rm_UnmapPointGrid(&g, screenPoints[i]);
+    } else {
+        rm_UnmapPointsInverse(&t.edges, t.inverse, screenPoints, texturePoints, count);
     }
-    
-    Matrix3x3 invH = rm_Matrix3x3Inverse(surface->homography);
-    Vector2 uv = rm_ApplyHomography(invH, screenPoint.x, screenPoint.y);
-    
-    // Clamp result
-    uv.x = fmaxf(0.0f, fminf(1.0f, uv.x));
-    uv.y = fmaxf(0.0f, fminf(1.0f, uv.y));
-    
-    return uv;
 }
 
 //--------------------------------------------------------------------------------------------
@@ -1564,6 +7111,226 @@ RMAPI Mesh *RM_GetSurfaceMesh(RM_Surface *surface)
     return &surface->mesh;
 }
 
+// Per-vertex evaluation the mesh kernels are checked against
+static void rm_ComputeMeshPositionsReference(const RM_Surface *surface, float *vertices, int cols, int rows)
+{
+    RM_Quad q = surface->quad;
+    
+    for (int y = 0, i = 0; y <= rows; y++) {
+        for (int x = 0; x <= cols; x++, i++) {
+            float u = (float)x / (float)cols;
+            float v = (float)y / (float)rows;
+            
+            Vector2 pos;
+            if (surface->mode == RM_MAP_HOMOGRAPHY) {
+                pos = rm_ApplyHomography(surface->transform.homography, u, v);
+            } else if (surface->mode == RM_MAP_GRID) {
+                pos = rm_EvaluateGrid(&surface->grid, u, v, NULL, NULL);
+            } else {
+                pos = rm_BilinearInterpolation(q.topLeft, q.topRight, q.bottomLeft, q.bottomRight, u, v);
+            }
+            
+            vertices[i * 2 + 0] = pos.x;
+            vertices[i * 2 + 1] = pos.y;
+        }
+    }
+}
+
+RMAPI float RM_CompareMeshKernel(const RM_Surface *surface, int columns, int rows, double *kernelMs, double *referenceMs)
+{
+    if (!surface) return -1.0f;
+    if (columns < 1 || rows < 1 || columns > RM_MAX_MESH_RESOLUTION || rows > RM_MAX_MESH_RESOLUTION) {
+        TraceLog(LOG_WARNING, "RAYMAP: CompareMeshKernel - Invalid resolution %dx%d", columns, rows);
+        return -1.0f;
+    }
+    
+    int count = (columns + 1) * (rows + 1);
+    float *kernel = (float *)RMMALLOC(count * 2 * sizeof(float));
+    float *reference = (float *)RMMALLOC(count * 2 * sizeof(float));
+    if (!kernel || !reference) {
+        TraceLog(LOG_ERROR, "RAYMAP: CompareMeshKernel - Failed to allocate %d vertices", count);
+        if (kernel) RMFREE(kernel);
+        if (reference) RMFREE(reference);
+        return -1.0f;
+    }
+    
+    // Touch both buffers first so neither timing includes page faults
+    memset(kernel, 0, count * 2 * sizeof(float));
+    memset(reference, 0, count * 2 * sizeof(float));
+    
+    double start = GetTime();
+    rm_ComputeMeshPositions(surface, kernel, 2, columns, rows);
+    double middle = GetTime();
+    rm_ComputeMeshPositionsReference(surface, reference, columns, rows);
+    double end = GetTime();
+    
+    float maxError = 0.0f;
+    for (int i = 0; i < count * 2; i++) {
+        maxError = fmaxf(maxError, fabsf(kernel[i] - reference[i]));
+    }
+    
+    if (kernelMs) *kernelMs = (middle - start) * 1000.0;
+    if (referenceMs) *referenceMs = (end - middle) * 1000.0;
+    
+    RMFREE(kernel);
+    RMFREE(reference);
+    return maxError;
+}
+
+// Unit square -> quad homography from the 8x8 DLT system in double, Gaussian elimination with
+// partial pivoting: the reference. Returns false if the system is singular
+static bool rm_SolveHomographyDLT(const RM_Quad *q, double h[9])
+{
+    const double src[4][2] = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+    const Vector2 dst[4] = { q->topLeft, q->topRight, q->bottomRight, q->bottomLeft };
+    
+    // Two rows per correspondence: [A | b] with h8 = 1
+    double a[8][9] = { { 0.0 } };
+    for (int i = 0; i < 4; i++) {
+        double x = src[i][0], y = src[i][1];
+        double u = dst[i].x, v = dst[i].y;
+        double *r0 = a[i * 2];
+        double *r1 = a[i * 2 + 1];
+        r0[0] = x; r0[1] = y; r0[2] = 1.0; r0[6] = -u * x; r0[7] = -u * y; r0[8] = u;
+        r1[3] = x; r1[4] = y; r1[5] = 1.0; r1[6] = -v * x; r1[7] = -v * y; r1[8] = v;
+    }
+    
+    for (int k = 0; k < 8; k++) {
+        int pivot = k;
+        for (int i = k + 1; i < 8; i++) {
+            if (fabs(a[i][k]) > fabs(a[pivot][k])) pivot = i;
+        }
+        if (fabs(a[pivot][k]) < RM_EPSILON * 0.01) return false;
+        if (pivot != k) {
+            for (int j = 0; j < 9; j++) {
+                double t = a[k][j];
+                a[k][j] = a[pivot][j];
+                a[pivot][j] = t;
+            }
+        }
+        for (int i = k + 1; i < 8; i++) {
+            double factor = a[i][k] / a[k][k];
+            for (int j = k; j < 9; j++) a[i][j] -= factor * a[k][j];
+        }
+    }
+    
+    for (int i = 7; i >= 0; i--) {
+        double x = a[i][8];
+        for (int j = i + 1; j < 8; j++) x -= a[i][j] * h[j];
+        h[i] = x / a[i][i];
+    }
+    h[8] = 1.0;
+    return true;
+}
+
+// The same system in float: the solver replaced by rm_SquareToQuad, timed and checked as it
+// ran. Returns false if the system is singular
+static bool rm_SolveHomographyDLTFloat(const RM_Quad *q, float h[9])
+{
+    const float src[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+    const Vector2 dst[4] = { q->topLeft, q->topRight, q->bottomRight, q->bottomLeft };
+    
+    float a[8][9] = { { 0.0f } };
+    for (int i = 0; i < 4; i++) {
+        float x = src[i][0], y = src[i][1];
+        float u = dst[i].x, v = dst[i].y;
+        float *r0 = a[i * 2];
+        float *r1 = a[i * 2 + 1];
+        r0[0] = x; r0[1] = y; r0[2] = 1.0f; r0[6] = -u * x; r0[7] = -u * y; r0[8] = u;
+        r1[3] = x; r1[4] = y; r1[5] = 1.0f; r1[6] = -v * x; r1[7] = -v * y; r1[8] = v;
+    }
+    
+    for (int k = 0; k < 8; k++) {
+        int pivot = k;
+        for (int i = k + 1; i < 8; i++) {
+            if (fabsf(a[i][k]) > fabsf(a[pivot][k])) pivot = i;
+        }
+        if (fabsf(a[pivot][k]) < RM_EPSILON * 0.01f) return false;
+        if (pivot != k) {
+            for (int j = 0; j < 9; j++) {
+                float t = a[k][j];
+                a[k][j] = a[pivot][j];
+                a[pivot][j] = t;
+            }
+        }
+        for (int i = k + 1; i < 8; i++) {
+            float factor = a[i][k] / a[k][k];
+            for (int j = k; j < 9; j++) a[i][j] -= factor * a[k][j];
+        }
+    }
+    
+    for (int i = 7; i >= 0; i--) {
+        float x = a[i][8];
+        for (int j = i + 1; j < 8; j++) x -= a[i][j] * h[j];
+        h[i] = x / a[i][i];
+    }
+    h[8] = 1.0f;
+    return true;
+}
+
+// Largest distance between the points of two homographies on a 9x9 grid of the unit square
+static double rm_CompareHomographyPoints(const double a[9], const double b[9])
+{
+    double maxError = 0.0;
+    for (int j = 0; j <= 8; j++) {
+        for (int i = 0; i <= 8; i++) {
+            double u = i / 8.0, v = j / 8.0;
+            double wa = a[6] * u + a[7] * v + a[8];
+            double wb = b[6] * u + b[7] * v + b[8];
+            double dx = (a[0] * u + a[1] * v + a[2]) / wa - (b[0] * u + b[1] * v + b[2]) / wb;
+            double dy = (a[3] * u + a[4] * v + a[5]) / wa - (b[3] * u + b[4] * v + b[5]) / wb;
+            maxError = fmax(maxError, sqrt(dx * dx + dy * dy));
+        }
+    }
+    return maxError;
+}
+
+RMAPI float RM_CompareHomographies(const RM_Quad *quads, int count, float *gaussError, double *closedFormMs, double *gaussMs)
+{
+    if (!quads || count <= 0) return -1.0f;
+    
+    // Both solvers write their results out, and the errors below read them back
+    float *closedForm = (float *)RMMALLOC((size_t)count * 9 * sizeof(float));
+    float *gauss = (float *)RMMALLOC((size_t)count * 9 * sizeof(float));
+    if (!closedForm || !gauss) {
+        TraceLog(LOG_ERROR, "RAYMAP: Failed to allocate homography comparison buffer");
+        if (closedForm) RMFREE(closedForm);
+        if (gauss) RMFREE(gauss);
+        return -1.0f;
+    }
+    
+    double start = GetTime();
+    RM_ComputeHomographies(quads, count, closedForm);
+    double middle = GetTime();
+    for (int i = 0; i < count; i++) {
+        // h8 = 0 marks a singular system
+        if (!rm_SolveHomographyDLTFloat(&quads[i], &gauss[i * 9])) gauss[i * 9 + 8] = 0.0f;
+    }
+    double end = GetTime();
+    
+    // Quads the reference cannot solve are degenerate for both solvers: skipped
+    double closedFormError = 0.0, floatGaussError = 0.0;
+    for (int i = 0; i < count; i++) {
+        double reference[9], h[9];
+        if (!rm_SolveHomographyDLT(&quads[i], reference)) continue;
+        
+        for (int k = 0; k < 9; k++) h[k] = closedForm[i * 9 + k];
+        closedFormError = fmax(closedFormError, rm_CompareHomographyPoints(h, reference));
+        if (gauss[i * 9 + 8] != 0.0f) {
+            for (int k = 0; k < 9; k++) h[k] = gauss[i * 9 + k];
+            floatGaussError = fmax(floatGaussError, rm_CompareHomographyPoints(h, reference));
+        }
+    }
+    
+    if (gaussError) *gaussError = (float)floatGaussError;
+    if (closedFormMs) *closedFormMs = (middle - start) * 1000.0;
+    if (gaussMs) *gaussMs = (end - middle) * 1000.0;
+    
+    RMFREE(closedForm);
+    RMFREE(gauss);
+    return (float)closedFormError;
+}
+
 #endif // RAYMAP_DEBUG
 
 #endif // RAYMAP_IMPLEMENTATION
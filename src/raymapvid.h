@@ -112,6 +112,7 @@ RMVAPI RMV_VideoInfo RMV_GetVideoInfo(const RMV_Video *video);
 
 // Texture access
 RMVAPI Texture2D RMV_GetVideoTexture(const RMV_Video *video);
+RMVAPI unsigned int RMV_GetVideoFrameGeneration(const RMV_Video *video);  // Changes when the texture is updated
 
 // Playback control
 RMVAPI void RMV_UpdateVideo(RMV_Video *video, float deltaTime);
@@ -203,6 +204,7 @@ struct RMV_Video {
     Texture2D texture;
     uint8_t *rgbBuffer;
     bool textureCreated;
+    unsigned int frameGeneration;   // Incremented on every texture upload
 
     // Video Metadata
     int width;
@@ -303,6 +305,7 @@ static bool rmv_CreateTexture(RMV_Video *video){
     }
 
     video->textureCreated = true;
+    video->frameGeneration++;
     TraceLog(LOG_INFO, "RAYMAPVID: Texture created (%dx%d)", video->width, video->height);
     return true;
 }
@@ -620,6 +623,15 @@ RMVAPI Texture2D RMV_GetVideoTexture(const RMV_Video *video) {
     return video->texture;
 }
 
+RMVAPI unsigned int RMV_GetVideoFrameGeneration(const RMV_Video *video) {
+
+    if (!rmv_ValidateVideo(video, "RMV_GetVideoFrameGeneration")) {
+        return 0;
+    }
+
+    return video->frameGeneration;
+}
+
 RMVAPI void RMV_UpdateVideo(RMV_Video *video, float deltaTime) {
 
     if (!rmv_ValidateVideo(video, "RMV_UpdateVideo")) {
@@ -712,6 +724,7 @@ RMVAPI void RMV_UpdateVideo(RMV_Video *video, float deltaTime) {
 
                     // Update texture with new frame
                     UpdateTexture(video->texture, video->rgbBuffer);
+                    video->frameGeneration++;
 
                     frameDecoded = true;
 